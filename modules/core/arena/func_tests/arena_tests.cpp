@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/arena/include/arena.hpp"
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/perf.hpp"
+
+TEST(arena_tests, check_alignment) {
+  ppc::core::BufferArena arena;
+  for (size_t size : {1, 3, 64, 100, 4096}) {
+    auto *ptr = arena.acquire(size);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % ppc::core::BufferArena::alignment, 0U);
+  }
+  ASSERT_EQ(arena.allocations_count(), 5U);
+}
+
+TEST(arena_tests, check_reuse_of_released_buffers) {
+  ppc::core::BufferArena arena;
+  auto *big = arena.acquire(1024);
+  auto *small = arena.acquire(128);
+  arena.release(big);
+  arena.release(small);
+  ASSERT_EQ(arena.used_bytes(), 0U);
+
+  // The smallest fitting buffer has to be given out
+  ASSERT_EQ(arena.acquire(100), small);
+  ASSERT_EQ(arena.acquire(512), big);
+  ASSERT_EQ(arena.allocations_count(), 2U);
+  ASSERT_EQ(arena.owned_bytes(), 1024U + 128U);
+  ASSERT_EQ(arena.used_bytes(), arena.owned_bytes());
+
+  std::vector<uint8_t> foreign(8);
+  ASSERT_ANY_THROW(arena.release(foreign.data()));
+}
+
+TEST(arena_tests, check_huge_pages) {
+  ppc::core::BufferArena arena(true);
+  auto *ptr = arena.acquire(100);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % ppc::core::BufferArena::huge_page_size, 0U);
+  ASSERT_EQ(arena.owned_bytes(), ppc::core::BufferArena::huge_page_size);
+}
+
+TEST(arena_tests, check_no_allocations_between_pipeline_runs) {
+  ppc::core::BufferArena arena;
+  size_t owned_bytes = 0;
+  for (int i = 0; i < 5; i++) {
+    // Create TaskData
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    auto in = arena.add_input<uint32_t>(*taskData, 2000);
+    auto out = arena.add_output<uint32_t>(*taskData, 1);
+    std::fill(in.begin(), in.end(), 1);
+
+    // Create Task
+    auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+    // Create Perf attributes
+    auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+    perfAttr->num_running = 10;
+
+    // Create and init perf results
+    auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+    // Create Perf analyzer
+    ppc::core::Perf perfAnalyzer(testTask);
+    perfAnalyzer.pipeline_run(perfAttr, perfResults);
+    EXPECT_EQ(out[0], in.size());
+
+    if (i == 0) owned_bytes = arena.owned_bytes();
+    arena.release(*taskData);
+    ASSERT_TRUE(taskData->inputs.empty());
+  }
+  ASSERT_EQ(arena.allocations_count(), 2U);
+  ASSERT_EQ(arena.owned_bytes(), owned_bytes);
+  ASSERT_EQ(arena.used_bytes(), 0U);
+}
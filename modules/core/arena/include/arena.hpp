@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ARENA_HPP_
+#define MODULES_CORE_INCLUDE_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Owner of aligned buffers for inputs and outputs of TaskData. Released
+// buffers stay in the arena and are given out again, so repeated runs with
+// the same sizes of data do not allocate memory.
+class BufferArena {
+ public:
+  // alignment of every buffer (size of cache line)
+  static constexpr size_t alignment = 64;
+  // size and alignment of buffers backed by huge pages
+  static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+  explicit BufferArena(bool use_huge_pages_ = false);
+  BufferArena(const BufferArena &) = delete;
+  BufferArena &operator=(const BufferArena &) = delete;
+  ~BufferArena();
+
+  // get buffer of at least size bytes, the smallest released one if it fits
+  uint8_t *acquire(size_t size);
+
+  // give buffer back to the arena
+  void release(uint8_t *ptr);
+
+  // get buffer of count elements of T
+  template <class T>
+  std::span<T> acquire_as(size_t count) {
+    return {reinterpret_cast<T *>(acquire(count * sizeof(T))), count};
+  }
+
+  // attach buffer of count elements of T as next input of taskData
+  template <class T>
+  std::span<T> add_input(TaskData &taskData, std::uint32_t count) {
+    auto buffer = acquire_as<T>(count);
+    taskData.inputs.emplace_back(reinterpret_cast<uint8_t *>(buffer.data()));
+    taskData.inputs_count.emplace_back(count);
+    return buffer;
+  }
+
+  // attach buffer of count elements of T as next output of taskData
+  template <class T>
+  std::span<T> add_output(TaskData &taskData, std::uint32_t count) {
+    auto buffer = acquire_as<T>(count);
+    taskData.outputs.emplace_back(reinterpret_cast<uint8_t *>(buffer.data()));
+    taskData.outputs_count.emplace_back(count);
+    return buffer;
+  }
+
+  // give back all buffers of taskData owned by the arena and clear its inputs
+  // and outputs
+  void release(TaskData &taskData);
+
+  // bytes of all buffers owned by the arena, used and released
+  [[nodiscard]] size_t owned_bytes() const;
+
+  // bytes of buffers which are in use now
+  [[nodiscard]] size_t used_bytes() const;
+
+  // count of memory allocations made by the arena
+  [[nodiscard]] size_t allocations_count() const;
+
+ private:
+  struct Block {
+    uint8_t *ptr;
+    size_t size;
+    bool in_use;
+  };
+
+  Block *find(const uint8_t *ptr);
+  [[nodiscard]] size_t block_alignment() const;
+
+  std::vector<Block> blocks;
+  bool use_huge_pages;
+  size_t allocations = 0;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ARENA_HPP_
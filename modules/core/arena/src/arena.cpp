@@ -0,0 +1,93 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/arena/include/arena.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <new>
+#include <stdexcept>
+
+ppc::core::BufferArena::BufferArena(bool use_huge_pages_) : use_huge_pages(use_huge_pages_) {}
+
+ppc::core::BufferArena::~BufferArena() {
+  for (auto &block : blocks) {
+    ::operator delete(block.ptr, std::align_val_t{block_alignment()});
+  }
+}
+
+size_t ppc::core::BufferArena::block_alignment() const { return use_huge_pages ? huge_page_size : alignment; }
+
+uint8_t *ppc::core::BufferArena::acquire(size_t size) {
+  // Best fit among released buffers
+  Block *best = nullptr;
+  for (auto &block : blocks) {
+    if (!block.in_use && block.size >= size && (best == nullptr || block.size < best->size)) {
+      best = &block;
+    }
+  }
+  if (best != nullptr) {
+    best->in_use = true;
+    return best->ptr;
+  }
+
+  auto block_size = (size + block_alignment() - 1) / block_alignment() * block_alignment();
+  if (block_size == 0) block_size = block_alignment();
+  auto *ptr = static_cast<uint8_t *>(::operator new(block_size, std::align_val_t{block_alignment()}));
+#ifdef __linux__
+  if (use_huge_pages) {
+    // Transparent huge pages are only a hint, so failure is not an error
+    madvise(ptr, block_size, MADV_HUGEPAGE);
+  }
+#endif
+  blocks.push_back({ptr, block_size, true});
+  allocations++;
+  return ptr;
+}
+
+ppc::core::BufferArena::Block *ppc::core::BufferArena::find(const uint8_t *ptr) {
+  for (auto &block : blocks) {
+    if (block.ptr == ptr) return &block;
+  }
+  return nullptr;
+}
+
+void ppc::core::BufferArena::release(uint8_t *ptr) {
+  if (ptr == nullptr) return;
+  auto *block = find(ptr);
+  if (block == nullptr) {
+    throw std::invalid_argument("Buffer is not owned by the arena");
+  }
+  block->in_use = false;
+}
+
+void ppc::core::BufferArena::release(TaskData &taskData) {
+  for (auto *buffers : {&taskData.inputs, &taskData.outputs}) {
+    for (auto *ptr : *buffers) {
+      auto *block = find(ptr);
+      if (block != nullptr) block->in_use = false;
+    }
+  }
+  taskData.inputs.clear();
+  taskData.inputs_count.clear();
+  taskData.outputs.clear();
+  taskData.outputs_count.clear();
+}
+
+size_t ppc::core::BufferArena::owned_bytes() const {
+  size_t bytes = 0;
+  for (const auto &block : blocks) {
+    bytes += block.size;
+  }
+  return bytes;
+}
+
+size_t ppc::core::BufferArena::used_bytes() const {
+  size_t bytes = 0;
+  for (const auto &block : blocks) {
+    if (block.in_use) bytes += block.size;
+  }
+  return bytes;
+}
+
+size_t ppc::core::BufferArena::allocations_count() const { return allocations; }
@@ -0,0 +1,128 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/async/include/async.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+struct Job {
+  std::vector<int32_t> in;
+  std::vector<int32_t> out = {0};
+  std::shared_ptr<ppc::test::TestTask<int32_t>> task;
+
+  explicit Job(size_t size, int32_t value) : in(size, value) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    taskData->inputs_count.emplace_back(in.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskData->outputs_count.emplace_back(out.size());
+    task = std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  }
+};
+
+class ThrowingTask : public ppc::core::Task {
+ public:
+  explicit ThrowingTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+  bool validation() override { throw std::runtime_error("validation error"); }
+  bool pre_processing() override { return true; }
+  bool run() override { return true; }
+  bool post_processing() override { return true; }
+};
+
+// coroutine which starts immediately and isn't awaited
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Detached run_jobs(Job &first, Job &second, ppc::core::Executor &executor, std::promise<int> &done) {
+  int succeeded_count = 0;
+  if (co_await ppc::core::run_async(first.task, executor)) succeeded_count++;
+  if (co_await ppc::core::run_async(second.task, executor)) succeeded_count++;
+  done.set_value(succeeded_count);
+}
+
+}  // namespace
+
+TEST(async_tests, check_submit) {
+  Job job(100, 2);
+  auto future = ppc::core::submit(job.task);
+  ASSERT_TRUE(future.get());
+  ASSERT_EQ(job.out[0], 200);
+  ASSERT_EQ(job.task->get_current_phase(), ppc::core::Task::Phase::POST_PROCESSING);
+}
+
+TEST(async_tests, check_pool_executor) {
+  ppc::core::ThreadPool pool(1);
+  ppc::core::PoolExecutor executor(pool);
+  Job job(100, 3);
+  std::thread::id job_thread;
+  std::promise<void> done;
+  executor.execute([&] {
+    job_thread = std::this_thread::get_id();
+    done.set_value();
+  });
+  done.get_future().wait();
+  ASSERT_NE(job_thread, std::this_thread::get_id());
+  ASSERT_TRUE(ppc::core::submit(job.task, executor).get());
+  ASSERT_EQ(job.out[0], 300);
+
+  // without workers jobs run on the calling thread
+  pool.resize(0);
+  executor.execute([&] { job_thread = std::this_thread::get_id(); });
+  ASSERT_EQ(job_thread, std::this_thread::get_id());
+  Job first(10, 1);
+  Job second(10, 3);
+  std::promise<int> done_jobs;
+  auto succeeded_count = done_jobs.get_future();
+  run_jobs(first, second, executor, done_jobs);
+  ASSERT_EQ(succeeded_count.get(), 2);
+}
+
+TEST(async_tests, check_consecutive_jobs_overlap_preparation) {
+  ppc::core::ThreadExecutor executor(2);
+  std::vector<std::unique_ptr<Job>> jobs;
+  std::vector<std::future<bool>> futures;
+  for (int32_t i = 0; i < 10; i++) {
+    // data of the next job is prepared while previous ones run
+    jobs.push_back(std::make_unique<Job>(1000, i));
+    futures.push_back(ppc::core::submit(jobs.back()->task, executor));
+  }
+  for (size_t i = 0; i < jobs.size(); i++) {
+    ASSERT_TRUE(futures[i].get());
+    ASSERT_EQ(jobs[i]->out[0], static_cast<int32_t>(i) * 1000);
+  }
+}
+
+TEST(async_tests, check_exception_in_future) {
+  ppc::core::ThreadExecutor executor(1);
+  auto future = ppc::core::submit(std::make_shared<ThrowingTask>(std::make_shared<ppc::core::TaskData>()), executor);
+  ASSERT_THROW(future.get(), std::runtime_error);
+  ASSERT_THROW(static_cast<void>(ppc::core::submit(nullptr, executor)), std::invalid_argument);
+}
+
+TEST(async_tests, check_coroutine) {
+  ppc::core::ThreadExecutor executor(1);
+  Job first(10, 1);
+  Job second(10, 3);
+  std::promise<int> done;
+  auto succeeded_count = done.get_future();
+  run_jobs(first, second, executor, done);
+  ASSERT_EQ(succeeded_count.get(), 2);
+  ASSERT_EQ(first.out[0], 10);
+  ASSERT_EQ(second.out[0], 30);
+}
@@ -0,0 +1,95 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ASYNC_HPP_
+#define MODULES_CORE_INCLUDE_ASYNC_HPP_
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/pool/include/thread_pool.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Runs jobs submitted from any thread
+class Executor {
+ public:
+  virtual void execute(std::function<void()> job) = 0;
+  virtual ~Executor() = default;
+};
+
+// Executor running jobs in order of submission on a fixed set of threads
+class ThreadExecutor : public Executor {
+ public:
+  // count of hardware threads if num_threads is 0
+  explicit ThreadExecutor(size_t num_threads = 0);
+  ThreadExecutor(const ThreadExecutor&) = delete;
+  ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+
+  void execute(std::function<void()> job) override;
+
+  // waits for all submitted jobs
+  ~ThreadExecutor() override;
+
+ private:
+  std::mutex mutex;
+  std::condition_variable jobs_cv;
+  std::deque<std::function<void()>> jobs;
+  bool is_stopped = false;
+  std::vector<std::thread> threads;
+};
+
+// Executor running jobs on workers of a ThreadPool, so async tasks share threads
+// (and their affinity) with parallel calls of the pool. A pool without workers
+// runs jobs on the calling thread before execute() returns.
+class PoolExecutor : public Executor {
+ public:
+  explicit PoolExecutor(ThreadPool& pool_ = ThreadPool::instance()) : pool(pool_) {}
+
+  void execute(std::function<void()> job) override;
+
+ private:
+  ThreadPool& pool;
+};
+
+// process-wide executor backed by ThreadPool::instance()
+Executor& default_executor();
+
+// Run validation(), pre_processing(), run() and post_processing() of task on
+// executor; the future gets true if all phases returned true or the exception
+// thrown by a phase. Caller can prepare data of the next task meanwhile, but
+// it must not touch the task and its TaskData until the future is ready.
+std::future<bool> submit(std::shared_ptr<Task> task, Executor& executor = default_executor());
+
+// Awaitable running pipeline of task on executor, for coroutines:
+//   bool is_succeeded = co_await ppc::core::run_async(task);
+// The coroutine is resumed on the thread of executor which ran the task.
+class TaskAwaitable {
+ public:
+  TaskAwaitable(std::shared_ptr<Task> task_, Executor& executor_);
+
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  // result of pipeline; rethrows the exception thrown by a phase
+  bool await_resume();
+
+ private:
+  std::shared_ptr<Task> task;
+  Executor& executor;
+  bool is_succeeded = false;
+  std::exception_ptr error;
+};
+
+TaskAwaitable run_async(std::shared_ptr<Task> task, Executor& executor = default_executor());
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ASYNC_HPP_
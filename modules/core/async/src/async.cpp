@@ -0,0 +1,106 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/async/include/async.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+bool run_pipeline(ppc::core::Task& task) {
+  bool is_succeeded = task.validation() && task.pre_processing() && task.run() && task.post_processing();
+  task.end_trace_phase();
+  return is_succeeded;
+}
+
+}  // namespace
+
+ppc::core::ThreadExecutor::ThreadExecutor(size_t num_threads) {
+  if (num_threads == 0) num_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([this] {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        jobs_cv.wait(lock, [this] { return is_stopped || !jobs.empty(); });
+        if (jobs.empty()) return;
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+      }
+    });
+  }
+}
+
+void ppc::core::ThreadExecutor::execute(std::function<void()> job) {
+  {
+    std::lock_guard lock(mutex);
+    if (is_stopped) throw std::logic_error("ThreadExecutor is stopped");
+    jobs.push_back(std::move(job));
+  }
+  jobs_cv.notify_one();
+}
+
+ppc::core::ThreadExecutor::~ThreadExecutor() {
+  {
+    std::lock_guard lock(mutex);
+    is_stopped = true;
+  }
+  jobs_cv.notify_all();
+  for (auto& thread : threads) thread.join();
+}
+
+void ppc::core::PoolExecutor::execute(std::function<void()> job) {
+  if (pool.size() == 0) {
+    job();
+    return;
+  }
+  pool.submit(std::move(job));
+}
+
+ppc::core::Executor& ppc::core::default_executor() {
+  static PoolExecutor executor;
+  return executor;
+}
+
+std::future<bool> ppc::core::submit(std::shared_ptr<Task> task, Executor& executor) {
+  if (!task) throw std::invalid_argument("Can't submit empty task");
+  auto promise = std::make_shared<std::promise<bool>>();
+  auto future = promise->get_future();
+  executor.execute([task = std::move(task), promise] {
+    try {
+      promise->set_value(run_pipeline(*task));
+    } catch (...) {
+      task->end_trace_phase();
+      promise->set_exception(std::current_exception());
+    }
+  });
+  return future;
+}
+
+ppc::core::TaskAwaitable::TaskAwaitable(std::shared_ptr<Task> task_, Executor& executor_)
+    : task(std::move(task_)), executor(executor_) {
+  if (!task) throw std::invalid_argument("Can't await empty task");
+}
+
+void ppc::core::TaskAwaitable::await_suspend(std::coroutine_handle<> handle) {
+  executor.execute([this, handle] {
+    try {
+      is_succeeded = run_pipeline(*task);
+    } catch (...) {
+      task->end_trace_phase();
+      error = std::current_exception();
+    }
+    handle.resume();
+  });
+}
+
+bool ppc::core::TaskAwaitable::await_resume() {
+  if (error) std::rethrow_exception(error);
+  return is_succeeded;
+}
+
+ppc::core::TaskAwaitable ppc::core::run_async(std::shared_ptr<Task> task, Executor& executor) {
+  return {std::move(task), executor};
+}
@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "core/batch/include/task_batch.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+std::atomic<int> validations_count = 0;
+std::atomic<int> tasks_count = 0;
+
+class CountingTask : public ppc::test::TestTask<int> {
+ public:
+  explicit CountingTask(std::shared_ptr<ppc::core::TaskData> taskData_) : TestTask(taskData_) { tasks_count++; }
+
+  bool validation() override {
+    validations_count++;
+    return TestTask::validation();
+  }
+};
+
+struct Batch {
+  std::vector<std::vector<int>> inputs;
+  std::vector<std::vector<int>> outputs;
+  std::vector<std::shared_ptr<ppc::core::TaskData>> task_data;
+
+  Batch(size_t count, size_t size) : inputs(count), outputs(count, std::vector<int>(1)) {
+    for (size_t i = 0; i < count; i++) {
+      inputs[i].assign(size, static_cast<int>(i));
+      auto taskData = std::make_shared<ppc::core::TaskData>();
+      taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputs[i].data()));
+      taskData->inputs_count.emplace_back(inputs[i].size());
+      taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputs[i].data()));
+      taskData->outputs_count.emplace_back(outputs[i].size());
+      task_data.push_back(taskData);
+    }
+  }
+};
+
+ppc::core::TaskBatch make_batch() {
+  validations_count = 0;
+  tasks_count = 0;
+  return ppc::core::TaskBatch([](auto taskData) { return std::make_shared<CountingTask>(taskData); });
+}
+
+}  // namespace
+
+TEST(task_batch_tests, check_sequential_batch) {
+  Batch batch(100, 10);
+  auto results = make_batch().run(batch.task_data);
+  ASSERT_TRUE(results.validated);
+  ASSERT_EQ(results.tasks_count, 100U);
+  ASSERT_EQ(results.failed_count, 0U);
+  ASSERT_GT(results.tasks_per_sec, 0.0);
+  for (size_t i = 0; i < batch.outputs.size(); i++) ASSERT_EQ(batch.outputs[i][0], static_cast<int>(i) * 10);
+  ASSERT_EQ(validations_count, 1);
+  ASSERT_EQ(tasks_count, 1);
+}
+
+TEST(task_batch_tests, check_parallel_batch) {
+  Batch batch(101, 7);
+  auto results = make_batch().run(batch.task_data, 4);
+  ASSERT_EQ(results.failed_count, 0U);
+  for (size_t i = 0; i < batch.outputs.size(); i++) ASSERT_EQ(batch.outputs[i][0], static_cast<int>(i) * 7);
+  ASSERT_EQ(validations_count, 1);
+  ASSERT_EQ(tasks_count, 4);
+}
+
+TEST(task_batch_tests, check_failed_validation) {
+  Batch batch(5, 3);
+  for (auto &taskData : batch.task_data) taskData->outputs_count[0] = 2;
+  auto results = make_batch().run(batch.task_data, 2);
+  ASSERT_FALSE(results.validated);
+  ASSERT_EQ(results.failed_count, 5U);
+  ASSERT_EQ(tasks_count, 1);
+}
+
+TEST(task_batch_tests, check_different_layouts) {
+  Batch batch(3, 4);
+  batch.task_data[2]->inputs_count[0] = 3;
+  ASSERT_THROW(make_batch().run(batch.task_data), std::invalid_argument);
+  ASSERT_FALSE(ppc::core::TaskBatch::same_layout(*batch.task_data[0], *batch.task_data[2]));
+  ASSERT_TRUE(ppc::core::TaskBatch::same_layout(*batch.task_data[0], *batch.task_data[1]));
+}
+
+TEST(task_batch_tests, check_empty_batch_and_statistic) {
+  auto results = make_batch().run({});
+  ASSERT_EQ(results.tasks_count, 0U);
+  std::ostringstream out;
+  ppc::core::TaskBatch::print_statistic("sum", results, out);
+  ASSERT_EQ(out.str().rfind("batch:sum:0:0:", 0), 0U);
+}
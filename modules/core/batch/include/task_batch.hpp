@@ -0,0 +1,60 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TASK_BATCH_HPP_
+#define MODULES_CORE_INCLUDE_TASK_BATCH_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/pool/include/thread_pool.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct BatchResults {
+  // count of TaskData in the batch
+  uint64_t tasks_count = 0;
+  // count of TaskData for which a phase returned false
+  uint64_t failed_count = 0;
+  // validation() of the first TaskData returned true, otherwise no task ran
+  bool validated = false;
+  // time of the whole batch including creation of tasks (in seconds)
+  double time_sec = 0.0;
+  double tasks_per_sec = 0.0;
+};
+
+// Runs pipelines of one task over many TaskData with the same layout. Tasks
+// are created once per thread instead of once per TaskData and validation()
+// is called only for the first TaskData, so setup of small tasks is amortised.
+class TaskBatch {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  explicit TaskBatch(TaskFactory factory_);
+
+  // run pre_processing(), run() and post_processing() for every TaskData of
+  // batch; TaskData are split into num_threads contiguous parts run by threads
+  // of pool (one part per thread of pool if 0). Throws std::invalid_argument
+  // if layouts of TaskData differ; the first exception thrown by a task is
+  // rethrown after all parts finish.
+  BatchResults run(const std::vector<std::shared_ptr<TaskData>>& batch, size_t num_threads = 1,
+                   ThreadPool& pool = ThreadPool::instance()) const;
+
+  // TaskData have the same counts of inputs and outputs and the same counts of
+  // their elements
+  static bool same_layout(const TaskData& lhs, const TaskData& rhs);
+
+  // Print results as "batch:<name>:<tasks>:<failed>:<time>:<tasks/s>" line
+  static void print_statistic(const std::string& name, const BatchResults& results, std::ostream& out = std::cout);
+
+ private:
+  TaskFactory factory;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TASK_BATCH_HPP_
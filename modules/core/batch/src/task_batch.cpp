@@ -0,0 +1,66 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/batch/include/task_batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+ppc::core::TaskBatch::TaskBatch(TaskFactory factory_) : factory(std::move(factory_)) {
+  if (!factory) throw std::invalid_argument("TaskBatch needs factory of tasks");
+}
+
+bool ppc::core::TaskBatch::same_layout(const TaskData& lhs, const TaskData& rhs) {
+  return lhs.inputs.size() == rhs.inputs.size() && lhs.outputs.size() == rhs.outputs.size() &&
+         lhs.inputs_count == rhs.inputs_count && lhs.outputs_count == rhs.outputs_count;
+}
+
+ppc::core::BatchResults ppc::core::TaskBatch::run(const std::vector<std::shared_ptr<TaskData>>& batch,
+                                                  size_t num_threads, ThreadPool& pool) const {
+  BatchResults results;
+  results.tasks_count = batch.size();
+  if (batch.empty()) return results;
+  for (const auto& taskData : batch) {
+    if (!taskData || !same_layout(*taskData, *batch[0])) {
+      throw std::invalid_argument("TaskData of batch have different layouts");
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto first_task = factory(batch[0]);
+  results.validated = first_task->validation();
+  if (!results.validated) {
+    first_task->end_trace_phase();
+    results.failed_count = batch.size();
+    return results;
+  }
+
+  if (num_threads == 0) num_threads = pool.size() + 1;
+  num_threads = std::min(num_threads, batch.size());
+
+  std::atomic<uint64_t> failed_count = 0;
+  pool.run(num_threads, [&](size_t part) {
+    size_t begin = batch.size() * part / num_threads;
+    size_t end = batch.size() * (part + 1) / num_threads;
+    // the first part continues pipeline of the validated task
+    auto task = part == 0 ? first_task : factory(batch[begin]);
+    for (size_t i = begin; i < end; i++) {
+      if (i != 0) task->set_validated_data(batch[i]);
+      if (!(task->pre_processing() && task->run() && task->post_processing())) failed_count++;
+    }
+    task->end_trace_phase();
+  });
+
+  results.failed_count = failed_count;
+  results.time_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (results.time_sec > 0.0) results.tasks_per_sec = static_cast<double>(batch.size()) / results.time_sec;
+  return results;
+}
+
+void ppc::core::TaskBatch::print_statistic(const std::string& name, const BatchResults& results, std::ostream& out) {
+  out << "batch:" << name << ":" << results.tasks_count << ":" << results.failed_count << ":" << std::fixed
+      << std::setprecision(10) << results.time_sec << ":" << std::setprecision(1) << results.tasks_per_sec
+      << std::endl;
+}
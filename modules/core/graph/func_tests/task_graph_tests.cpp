@@ -0,0 +1,319 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/graph/include/task_graph.hpp"
+#include "core/pool/include/thread_pool.hpp"
+
+namespace {
+
+// Sums of rows of matrix with inputs_count[0] elements and outputs_count[0] rows
+class RowSumsTask : public ppc::core::Task {
+ public:
+  explicit RowSumsTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] != 0 && taskData->inputs_count[0] % taskData->outputs_count[0] == 0;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    input_ = taskData->input_as<const int>(0);
+    output_ = taskData->output_as<int>(0);
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    size_t columns = input_.size() / output_.size();
+    for (size_t i = 0; i < output_.size(); i++) {
+      output_[i] = 0;
+      for (size_t j = 0; j < columns; j++) output_[i] += input_[i * columns + j];
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::span<const int> input_;
+  std::span<int> output_;
+};
+
+// Maximum over all elements of all inputs; it remembers pointers of inputs
+class MaxTask : public ppc::core::Task {
+ public:
+  explicit MaxTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+
+  bool validation() override {
+    internal_order_test();
+    return !taskData->inputs.empty() && taskData->outputs_count[0] == 1;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    inputs_seen = taskData->inputs;
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    auto& result = taskData->output_as<int>(0)[0];
+    for (size_t i = 0; i < taskData->inputs.size(); i++) {
+      for (auto value : taskData->input_as<const int>(i)) result = std::max(result, value);
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  std::vector<uint8_t*> inputs_seen;
+};
+
+// Copy of input which waits until all tasks sharing started counter are run,
+// so it fails by timeout if they aren't run concurrently
+class WaitingCopyTask : public ppc::core::Task {
+ public:
+  WaitingCopyTask(std::shared_ptr<ppc::core::TaskData> taskData_, std::atomic<int>& started_, int tasks_count_)
+      : Task(taskData_), started(started_), tasks_count(tasks_count_) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs_count[0] == taskData->outputs_count[0];
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    started++;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (started.load() < tasks_count) {
+      if (std::chrono::steady_clock::now() > deadline) return false;
+      std::this_thread::yield();
+    }
+    auto input = taskData->input_as<const int>(0);
+    std::copy(input.begin(), input.end(), taskData->output_as<int>(0).begin());
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::atomic<int>& started;
+  int tasks_count;
+};
+
+// Sum of input by parallel_for of the pool
+class ParallelSumTask : public ppc::core::Task {
+ public:
+  ParallelSumTask(std::shared_ptr<ppc::core::TaskData> taskData_, ppc::core::ThreadPool& pool_)
+      : Task(taskData_), pool(pool_) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    auto input = taskData->input_as<const int>(0);
+    std::atomic<int> sum = 0;
+    ppc::core::parallel_for(
+        0, input.size(),
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++) sum += input[i];
+        },
+        1, pool);
+    taskData->output_as<int>(0)[0] = sum;
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  ppc::core::ThreadPool& pool;
+};
+
+class FailingTask : public ppc::core::Task {
+ public:
+  FailingTask(std::shared_ptr<ppc::core::TaskData> taskData_, bool throws_) : Task(taskData_), throws(throws_) {}
+
+  bool validation() override {
+    internal_order_test();
+    if (throws) throw std::runtime_error("validation error");
+    return false;
+  }
+
+  bool pre_processing() override { return true; }
+
+  bool run() override { return true; }
+
+  bool post_processing() override { return true; }
+
+ private:
+  bool throws;
+};
+
+std::shared_ptr<ppc::core::TaskData> make_data(std::vector<int>* in, std::vector<int>* out) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  if (in != nullptr) {
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in->data()));
+    taskData->inputs_count.emplace_back(in->size());
+  }
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out->data()));
+  taskData->outputs_count.emplace_back(out->size());
+  return taskData;
+}
+
+}  // namespace
+
+TEST(task_graph_tests, check_chain_without_copies) {
+  std::vector<int> matrix = {1, 2, 3, 9, 9, 9, -5, 0, 5, 4, 4, 4};
+  std::vector<int> sums(4);
+  std::vector<int> max(1);
+
+  ppc::core::TaskGraph graph;
+  auto sums_id = graph.add(std::make_shared<RowSumsTask>(make_data(&matrix, &sums)));
+  auto max_task = std::make_shared<MaxTask>(make_data(nullptr, &max));
+  auto max_id = graph.add(max_task);
+  graph.connect(sums_id, 0, max_id, 0);
+
+  ASSERT_TRUE(graph.run());
+  ASSERT_EQ(sums, std::vector<int>({6, 27, 0, 12}));
+  ASSERT_EQ(max[0], 27);
+  ASSERT_EQ(graph.status(sums_id), ppc::core::TaskGraph::NodeStatus::SUCCEEDED);
+  ASSERT_EQ(graph.status(max_id), ppc::core::TaskGraph::NodeStatus::SUCCEEDED);
+
+  // The consumer reads the buffer of the producer
+  ASSERT_EQ(max_task->inputs_seen.size(), 1U);
+  ASSERT_EQ(max_task->inputs_seen[0], reinterpret_cast<uint8_t*>(sums.data()));
+  ASSERT_EQ(max_task->get_data()->inputs_count[0], 4U);
+}
+
+TEST(task_graph_tests, check_diamond_runs_branches_concurrently) {
+  std::vector<int> matrix = {1, 2, 3, 4, 5, 6};
+  std::vector<int> sums(3);
+  std::vector<int> left(3);
+  std::vector<int> right(3);
+  std::vector<int> max(1);
+  std::atomic<int> started = 0;
+
+  ppc::core::TaskGraph graph;
+  auto sums_id = graph.add(std::make_shared<RowSumsTask>(make_data(&matrix, &sums)));
+  auto left_id = graph.add(std::make_shared<WaitingCopyTask>(make_data(&sums, &left), started, 2));
+  auto right_id = graph.add(std::make_shared<WaitingCopyTask>(make_data(&sums, &right), started, 2));
+  auto max_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &max)));
+  graph.connect(sums_id, 0, left_id, 0);
+  graph.connect(sums_id, 0, right_id, 0);
+  graph.connect(left_id, 0, max_id, 0);
+  graph.connect(right_id, 0, max_id, 1);
+
+  // pool with a worker besides the calling thread, whatever the count of CPUs is
+  ppc::core::ThreadPool pool(1);
+  ASSERT_TRUE(graph.run(pool));
+  ASSERT_EQ(left, std::vector<int>({3, 7, 11}));
+  ASSERT_EQ(right, left);
+  ASSERT_EQ(max[0], 11);
+}
+
+TEST(task_graph_tests, check_nodes_with_nested_parallel_calls) {
+  ppc::core::ThreadPool pool(2);
+  std::vector<int> in(1000, 1);
+  std::vector<std::vector<int>> sums(8, std::vector<int>(1));
+  std::vector<int> max(1);
+
+  // independent nodes run parallel_for on the pool which runs them
+  ppc::core::TaskGraph graph;
+  auto max_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &max)));
+  for (size_t i = 0; i < sums.size(); i++) {
+    auto sum_id = graph.add(std::make_shared<ParallelSumTask>(make_data(&in, &sums[i]), pool));
+    graph.connect(sum_id, 0, max_id, i);
+  }
+
+  ASSERT_TRUE(graph.run(pool));
+  for (auto& sum : sums) ASSERT_EQ(sum[0], 1000);
+  ASSERT_EQ(max[0], 1000);
+}
+
+TEST(task_graph_tests, check_cycle) {
+  std::vector<int> first(1);
+  std::vector<int> second(1);
+  ppc::core::TaskGraph graph;
+  auto first_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &first)));
+  auto second_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &second)));
+  graph.connect(first_id, 0, second_id, 0);
+  graph.connect(second_id, 0, first_id, 0);
+
+  ASSERT_THROW(graph.run(), std::invalid_argument);
+  ASSERT_EQ(graph.status(first_id), ppc::core::TaskGraph::NodeStatus::PENDING);
+}
+
+TEST(task_graph_tests, check_wrong_connections) {
+  std::vector<int> out(1);
+  ppc::core::TaskGraph graph;
+  auto id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &out)));
+  auto other_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &out)));
+  ASSERT_THROW(graph.connect(id, 1, other_id, 0), std::out_of_range);
+  ASSERT_THROW(graph.connect(id, 0, other_id, 1), std::out_of_range);
+  ASSERT_THROW(graph.connect(id, 0, 2, 0), std::out_of_range);
+  ASSERT_THROW(graph.connect(id, 0, id, 0), std::invalid_argument);
+  ASSERT_THROW(graph.add(nullptr), std::invalid_argument);
+}
+
+TEST(task_graph_tests, check_consumers_of_failed_task_are_skipped) {
+  std::vector<int> in = {1, 2};
+  std::vector<int> failed_out(1);
+  std::vector<int> sums(1);
+  std::vector<int> max(1);
+  std::vector<int> independent(1);
+
+  for (bool throws : {false, true}) {
+    ppc::core::TaskGraph graph;
+    auto failed_id = graph.add(std::make_shared<FailingTask>(make_data(&in, &failed_out), throws));
+    auto sums_id = graph.add(std::make_shared<RowSumsTask>(make_data(nullptr, &sums)));
+    auto max_id = graph.add(std::make_shared<MaxTask>(make_data(nullptr, &max)));
+    auto independent_id = graph.add(std::make_shared<RowSumsTask>(make_data(&in, &independent)));
+    graph.connect(failed_id, 0, sums_id, 0);
+    graph.connect(sums_id, 0, max_id, 0);
+
+    if (throws) {
+      ASSERT_THROW(graph.run(), std::runtime_error);
+    } else {
+      ASSERT_FALSE(graph.run());
+    }
+    ASSERT_EQ(graph.status(failed_id), ppc::core::TaskGraph::NodeStatus::FAILED);
+    ASSERT_EQ(graph.status(sums_id), ppc::core::TaskGraph::NodeStatus::SKIPPED);
+    ASSERT_EQ(graph.status(max_id), ppc::core::TaskGraph::NodeStatus::SKIPPED);
+    ASSERT_EQ(graph.status(independent_id), ppc::core::TaskGraph::NodeStatus::SUCCEEDED);
+    ASSERT_EQ(independent[0], 3);
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
+#define MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/pool/include/thread_pool.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Directed acyclic graph of tasks. Output of one task is wired to input of
+// another one, so the consumer reads the buffer written by the producer in
+// place instead of a copy. Every task runs its whole pipeline after all its
+// producers have finished; independent tasks run concurrently.
+class TaskGraph {
+ public:
+  using NodeId = size_t;
+
+  enum class NodeStatus : uint8_t {
+    // graph wasn't run yet
+    PENDING,
+    // all phases returned true
+    SUCCEEDED,
+    // a phase returned false or threw an exception
+    FAILED,
+    // a producer of the task failed, so the task wasn't run
+    SKIPPED
+  };
+
+  // add task with initialized TaskData; its inputs which are wired later can
+  // be nullptr
+  NodeId add(std::shared_ptr<Task> task);
+
+  // wire output with index output of producer to input with index input of
+  // consumer: the consumer gets pointer to the buffer and count of elements
+  // of the output; input can be the next index after existing inputs
+  void connect(NodeId producer, size_t output, NodeId consumer, size_t input);
+
+  // run pipelines of all tasks in order of dependencies on threads of pool:
+  // a task is submitted to the pool when all its producers have finished and
+  // the calling thread runs jobs of the pool meanwhile. Returns true if all
+  // tasks succeeded. Throws std::invalid_argument for graph with a cycle
+  // before running tasks; the first exception thrown by a task is rethrown
+  // after all tasks finish.
+  bool run(ThreadPool& pool = ThreadPool::instance());
+
+  [[nodiscard]] NodeStatus status(NodeId node) const;
+
+  [[nodiscard]] size_t size() const { return nodes.size(); }
+
+ private:
+  struct Node {
+    std::shared_ptr<Task> task;
+    std::vector<NodeId> consumers;
+    size_t producers_count = 0;
+    NodeStatus status = NodeStatus::PENDING;
+  };
+
+  // throws std::invalid_argument if graph has a cycle
+  void check_acyclic() const;
+  void check_node(NodeId node) const;
+
+  std::vector<Node> nodes;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
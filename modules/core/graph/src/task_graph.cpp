@@ -0,0 +1,124 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/graph/include/task_graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+ppc::core::TaskGraph::NodeId ppc::core::TaskGraph::add(std::shared_ptr<Task> task) {
+  if (!task) throw std::invalid_argument("TaskGraph can't contain empty task");
+  nodes.push_back(Node{std::move(task), {}, 0, NodeStatus::PENDING});
+  return nodes.size() - 1;
+}
+
+void ppc::core::TaskGraph::check_node(NodeId node) const {
+  if (node >= nodes.size()) throw std::out_of_range("TaskGraph has no node " + std::to_string(node));
+}
+
+void ppc::core::TaskGraph::connect(NodeId producer, size_t output, NodeId consumer, size_t input) {
+  check_node(producer);
+  check_node(consumer);
+  if (producer == consumer) throw std::invalid_argument("Task can't consume its own output");
+  auto producer_data = nodes[producer].task->get_data();
+  auto consumer_data = nodes[consumer].task->get_data();
+  if (output >= producer_data->outputs.size() || output >= producer_data->outputs_count.size()) {
+    throw std::out_of_range("Producer has no output with index " + std::to_string(output));
+  }
+  if (input > consumer_data->inputs.size() || input > consumer_data->inputs_count.size()) {
+    throw std::out_of_range("Consumer has no input with index " + std::to_string(input));
+  }
+
+  if (input == consumer_data->inputs.size()) {
+    consumer_data->inputs.push_back(nullptr);
+    consumer_data->inputs_count.push_back(0);
+  }
+  consumer_data->inputs[input] = producer_data->outputs[output];
+  consumer_data->inputs_count[input] = producer_data->outputs_count[output];
+
+  nodes[producer].consumers.push_back(consumer);
+  nodes[consumer].producers_count++;
+}
+
+// Kahn's algorithm: nodes of a cycle never lose all their producers
+void ppc::core::TaskGraph::check_acyclic() const {
+  std::vector<size_t> producers_left(nodes.size());
+  std::vector<NodeId> order;
+  for (NodeId id = 0; id < nodes.size(); id++) {
+    producers_left[id] = nodes[id].producers_count;
+    if (producers_left[id] == 0) order.push_back(id);
+  }
+  for (size_t i = 0; i < order.size(); i++) {
+    for (auto consumer : nodes[order[i]].consumers) {
+      if (--producers_left[consumer] == 0) order.push_back(consumer);
+    }
+  }
+  if (order.size() != nodes.size()) throw std::invalid_argument("TaskGraph has a cycle");
+}
+
+bool ppc::core::TaskGraph::run(ThreadPool& pool) {
+  check_acyclic();
+
+  std::mutex mutex;
+  std::vector<size_t> producers_left(nodes.size());
+  std::vector<bool> producer_failed(nodes.size(), false);
+  std::atomic<size_t> finished_count = 0;
+  std::exception_ptr first_error;
+  for (NodeId id = 0; id < nodes.size(); id++) {
+    nodes[id].status = NodeStatus::PENDING;
+    producers_left[id] = nodes[id].producers_count;
+  }
+
+  // runs pipeline of a ready node and submits consumers which become ready
+  std::function<void(NodeId)> run_node = [&](NodeId id) {
+    bool is_skipped = false;
+    {
+      std::lock_guard lock(mutex);
+      is_skipped = producer_failed[id];
+    }
+
+    auto status = NodeStatus::SKIPPED;
+    if (!is_skipped) {
+      auto& task = *nodes[id].task;
+      bool is_succeeded = false;
+      try {
+        is_succeeded = task.validation() && task.pre_processing() && task.run() && task.post_processing();
+      } catch (...) {
+        std::lock_guard lock(mutex);
+        if (!first_error) first_error = std::current_exception();
+      }
+      task.end_trace_phase();
+      status = is_succeeded ? NodeStatus::SUCCEEDED : NodeStatus::FAILED;
+    }
+
+    std::vector<NodeId> ready;
+    {
+      std::lock_guard lock(mutex);
+      nodes[id].status = status;
+      for (auto consumer : nodes[id].consumers) {
+        if (status != NodeStatus::SUCCEEDED) producer_failed[consumer] = true;
+        if (--producers_left[consumer] == 0) ready.push_back(consumer);
+      }
+    }
+    for (auto consumer : ready) pool.submit([&run_node, consumer] { run_node(consumer); });
+    // the last access to state of run(), it may return right after
+    finished_count.fetch_add(1);
+  };
+
+  for (NodeId id = 0; id < nodes.size(); id++) {
+    if (nodes[id].producers_count == 0) pool.submit([&run_node, id] { run_node(id); });
+  }
+  pool.help_until([&] { return finished_count.load() == nodes.size(); });
+
+  if (first_error) std::rethrow_exception(first_error);
+  return std::all_of(nodes.begin(), nodes.end(), [](const Node& node) { return node.status == NodeStatus::SUCCEEDED; });
+}
+
+ppc::core::TaskGraph::NodeStatus ppc::core::TaskGraph::status(NodeId node) const {
+  check_node(node);
+  return nodes[node].status;
+}
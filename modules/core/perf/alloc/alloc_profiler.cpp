@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+
+// Interposer of global operator new/delete: every allocation is accounted in
+// ppc::core::AllocStats for the phase of task being executed. Size of block
+// is kept in a header before it, so all forms of delete know it. This file is
+// linked into executables on request only (USE_ALLOC_PROFILER).
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "core/perf/include/alloc_stats.hpp"
+
+namespace {
+
+struct BlockHeader {
+  void* raw;
+  size_t size;
+};
+
+constexpr size_t header_size = 16;
+static_assert(sizeof(BlockHeader) <= header_size);
+
+const bool is_registered = (ppc::core::AllocStats::mark_enabled(), true);
+
+void* allocate(size_t size, size_t alignment) noexcept {
+  if (alignment < header_size) alignment = header_size;
+  void* raw = std::malloc(size + header_size + alignment);
+  if (raw == nullptr) return nullptr;
+  auto address = reinterpret_cast<uintptr_t>(raw) + header_size;
+  address = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+  auto* ptr = reinterpret_cast<void*>(address);
+  *(reinterpret_cast<BlockHeader*>(ptr) - 1) = BlockHeader{raw, size};
+  ppc::core::AllocStats::record_allocation(size);
+  return ptr;
+}
+
+void* allocate_or_throw(size_t size, size_t alignment) {
+  while (true) {
+    void* ptr = allocate(size, alignment);
+    if (ptr != nullptr) return ptr;
+    auto handler = std::get_new_handler();
+    if (handler == nullptr) throw std::bad_alloc();
+    handler();
+  }
+}
+
+void deallocate(void* ptr) noexcept {
+  if (ptr == nullptr) return;
+  auto header = *(reinterpret_cast<BlockHeader*>(ptr) - 1);
+  ppc::core::AllocStats::record_deallocation(header.size);
+  std::free(header.raw);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return allocate_or_throw(size, 0); }
+void* operator new[](size_t size) { return allocate_or_throw(size, 0); }
+void* operator new(size_t size, const std::nothrow_t& /*tag*/) noexcept { return allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t& /*tag*/) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t /*size*/) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t /*size*/) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t /*alignment*/) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+  deallocate(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+  deallocate(ptr);
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/alloc_stats.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/task/func_tests/buffered_sum_task.hpp"
+
+TEST(alloc_tests, check_perf_alloc_stats) {
+  ASSERT_TRUE(ppc::core::AllocStats::enabled());
+
+  // Create data
+  std::vector<uint32_t> in(1000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task, every run allocates a copy of input
+  auto testTask = std::make_shared<ppc::test::TestAllocTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  using Phase = ppc::core::Task::Phase;
+  const auto &run_stats = perfResults->alloc_stats.at(Phase::RUN);
+  EXPECT_EQ(run_stats.allocations, 10U);
+  EXPECT_EQ(run_stats.deallocations, 9U);
+  EXPECT_EQ(run_stats.allocated_bytes, 10 * in.size() * sizeof(uint32_t));
+  EXPECT_GE(run_stats.peak_live_bytes, in.size() * sizeof(uint32_t));
+  EXPECT_EQ(perfResults->alloc_stats.at(Phase::VALIDATION).allocations, 0U);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(alloc_tests, check_rebind_runs_dont_allocate) {
+  ASSERT_TRUE(ppc::core::AllocStats::enabled());
+  std::vector<int32_t> first(1000, 1);
+  std::vector<int32_t> second(1000, 2);
+  std::vector<int32_t> out(1, 0);
+  std::array<std::shared_ptr<ppc::core::TaskData>, 2> taskData = {ppc::test::make_task_data(first, out),
+                                                                  ppc::test::make_task_data(second, out)};
+
+  ppc::test::BufferedSumTask task(taskData[0]);
+  ASSERT_TRUE(task.rebind(taskData[0]) && task.pre_processing() && task.run() && task.post_processing());
+
+  auto snapshot = ppc::core::AllocStats::snapshot();
+  for (size_t i = 1; i <= 10; i++) {
+    ASSERT_TRUE(task.rebind(taskData[i % 2]));
+    ASSERT_TRUE(task.pre_processing() && task.run() && task.post_processing());
+    ASSERT_EQ(out[0], i % 2 == 0 ? 1000 : 2000);
+  }
+  ASSERT_EQ(ppc::core::AllocStats::snapshot().since(snapshot).total().allocations, 0U);
+}
+
+TEST(alloc_tests, check_allocations_after_pipeline_are_outside_of_tasks) {
+  ASSERT_TRUE(ppc::core::AllocStats::enabled());
+  std::vector<int32_t> in(10, 1);
+  std::vector<int32_t> out(1, 0);
+  ppc::test::BufferedSumTask task(ppc::test::make_task_data(in, out));
+  ASSERT_TRUE(task.validation() && task.pre_processing() && task.run() && task.post_processing());
+  task.end_trace_phase();
+
+  auto snapshot = ppc::core::AllocStats::snapshot();
+  auto buffer = std::make_unique<std::vector<int32_t>>(100);
+  auto stats = ppc::core::AllocStats::snapshot().since(snapshot);
+  ASSERT_GE(stats.at(ppc::core::Task::Phase::NONE).allocations, 2U);
+  ASSERT_EQ(stats.at(ppc::core::Task::Phase::POST_PROCESSING).allocations, 0U);
+}
@@ -0,0 +1,6 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/bench.hpp"
+
+// Entry point of benchmark executables, benchmarks are registered by static
+// initializers of their translation units
+int main(int argc, char** argv) { return ppc::core::Bench::main(argc, argv); }
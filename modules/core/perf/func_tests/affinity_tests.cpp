@@ -0,0 +1,122 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/affinity.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/pool/include/thread_pool.hpp"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+TEST(affinity_tests, check_placement_policies) {
+  auto topology = ppc::core::Affinity::topology();
+  auto compact = ppc::core::Affinity::placement(ppc::core::AffinityPolicy::COMPACT);
+  auto scatter = ppc::core::Affinity::placement(ppc::core::AffinityPolicy::SCATTER);
+  auto physical = ppc::core::Affinity::placement(ppc::core::AffinityPolicy::PHYSICAL_CORES);
+  EXPECT_EQ(compact.size(), topology.size());
+  EXPECT_TRUE(std::is_permutation(compact.begin(), compact.end(), scatter.begin(), scatter.end()));
+  EXPECT_LE(physical.size(), compact.size());
+  for (const auto &info : topology) {
+    bool is_first_thread = std::find(physical.begin(), physical.end(), info.cpu) != physical.end();
+    EXPECT_EQ(is_first_thread, info.smt == 0);
+  }
+  EXPECT_TRUE(ppc::core::Affinity::placement(ppc::core::AffinityPolicy::NONE).empty());
+  EXPECT_EQ(ppc::core::Affinity::placement(ppc::core::AffinityPolicy::EXPLICIT, {3, 1}), std::vector<int>({3, 1}));
+}
+
+TEST(affinity_tests, check_scoped_affinity) {
+  auto compact = ppc::core::Affinity::placement(ppc::core::AffinityPolicy::COMPACT);
+  if (compact.empty()) GTEST_SKIP() << "CPU affinity is not supported";
+  EXPECT_EQ(ppc::core::Affinity::get_policy(), ppc::core::AffinityPolicy::NONE);
+  {
+    ppc::core::ScopedAffinity affinity(ppc::core::AffinityPolicy::EXPLICIT, {compact.back()});
+    EXPECT_EQ(ppc::core::Affinity::get_policy(), ppc::core::AffinityPolicy::EXPLICIT);
+#ifdef __linux__
+    EXPECT_EQ(sched_getcpu(), compact.back());
+#endif
+    // Workers are pinned by the same policy
+    bool is_pinned = false;
+    std::thread([&] { is_pinned = ppc::core::Affinity::pin_worker(1); }).join();
+    EXPECT_TRUE(is_pinned);
+  }
+  EXPECT_EQ(ppc::core::Affinity::get_policy(), ppc::core::AffinityPolicy::NONE);
+  EXPECT_FALSE(ppc::core::Affinity::pin_worker(0));
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  sched_getaffinity(0, sizeof(mask), &mask);
+  EXPECT_EQ(static_cast<size_t>(CPU_COUNT(&mask)), compact.size());
+#endif
+}
+
+#ifdef __linux__
+TEST(affinity_tests, check_scoped_affinity_restores_workers) {
+  auto compact = ppc::core::Affinity::placement(ppc::core::AffinityPolicy::COMPACT);
+  if (compact.empty()) GTEST_SKIP() << "CPU affinity is not supported";
+  ppc::core::ThreadPool pool(1);
+  // count of CPUs of the worker: job 0 runs on the calling thread and waits
+  // till the worker takes job 1
+  auto worker_cpus_count = [&] {
+    std::atomic<int> count = 0;
+    pool.run(2, [&](size_t i) {
+      if (i == 0) {
+        while (count.load() == 0) std::this_thread::yield();
+        return;
+      }
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      sched_getaffinity(0, sizeof(mask), &mask);
+      count = CPU_COUNT(&mask);
+    });
+    return static_cast<size_t>(count.load());
+  };
+  {
+    ppc::core::ScopedAffinity affinity(ppc::core::AffinityPolicy::EXPLICIT, {compact.back()},
+                                       [&] { pool.pin_workers(); });
+    EXPECT_EQ(worker_cpus_count(), 1U);
+  }
+  EXPECT_EQ(worker_cpus_count(), compact.size());
+}
+#endif
+
+TEST(affinity_tests, check_perf_affinity) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->affinity = ppc::core::AffinityPolicy::PHYSICAL_CORES;
+  int pin_workers_calls = 0;
+  perfAttr->pin_workers = [&] { pin_workers_calls++; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->affinity, ppc::core::AffinityPolicy::PHYSICAL_CORES);
+  // workers are pinned in the scope and restored after it
+  EXPECT_EQ(pin_workers_calls, 2);
+  EXPECT_EQ(ppc::core::Affinity::get_policy(), ppc::core::AffinityPolicy::NONE);
+  EXPECT_EQ(out[0], in.size());
+}
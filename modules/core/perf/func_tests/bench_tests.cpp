@@ -0,0 +1,68 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/bench.hpp"
+
+TEST(bench_tests, check_sizes_from_l1_to_dram) {
+  auto sizes = ppc::core::Bench::sizes(sizeof(int32_t));
+  ASSERT_EQ(sizes.size(), 4U);
+  EXPECT_EQ(sizes.front(), 4096U);
+  EXPECT_TRUE(std::is_sorted(sizes.begin(), sizes.end()));
+  EXPECT_EQ(ppc::core::Bench::sizes(sizeof(double)).front(), 2048U);
+}
+
+TEST(bench_tests, check_type_names) {
+  EXPECT_EQ(ppc::core::Bench::type_name<int32_t>(), "int32_t");
+  EXPECT_EQ(ppc::core::Bench::type_name<uint64_t>(), "uint64_t");
+  EXPECT_EQ(ppc::core::Bench::type_name<float>(), "float");
+  EXPECT_EQ(ppc::core::Bench::type_name<double>(), "double");
+}
+
+TEST(bench_tests, check_run_of_registered_benchmarks) {
+  std::vector<uint64_t> created_sizes;
+  ppc::core::Bench::add_for_types<int32_t, double>(
+      "bench_tests_sum", [&](auto type, ppc::core::BenchData& data, uint64_t size) -> std::shared_ptr<ppc::core::Task> {
+        using T = typename decltype(type)::type;
+        auto input = data.add_input<T>(size);
+        std::fill(input.begin(), input.end(), T(1));
+        data.add_output<T>(1);
+        created_sizes.push_back(size);
+        return std::make_shared<ppc::test::TestTask<T>>(data.task_data());
+      });
+
+  // Only benchmarks of L1-resident input are run
+  ppc::core::BenchOptions options;
+  options.filter = "^bench_tests_sum<.*>/(4096|2048)$";
+  options.min_time_sec = 0.001;
+  std::ostringstream output;
+  auto results = ppc::core::Bench::run(options, output);
+
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_EQ(created_sizes, std::vector<uint64_t>({4096, 2048}));
+  EXPECT_EQ(results[0].name, "bench_tests_sum<int32_t>");
+  EXPECT_EQ(results[1].name, "bench_tests_sum<double>");
+  for (const auto& result : results) {
+    EXPECT_GT(result.results->num_running, 0U);
+    EXPECT_GT(result.elements_per_sec, 0.0);
+  }
+  EXPECT_EQ(output.str().rfind("bench:bench_tests_sum<int32_t>/4096:", 0), 0U);
+}
+
+TEST(bench_tests, check_bench_data) {
+  ppc::core::BenchData data;
+  auto input = data.add_input<int64_t>(1000);
+  data.add_output<double>(2);
+  ppc::core::BenchData::fill_random<int64_t>(input, -5, 5);
+  EXPECT_TRUE(std::all_of(input.begin(), input.end(), [](int64_t value) { return value >= -5 && value <= 5; }));
+
+  auto taskData = data.task_data();
+  EXPECT_EQ(taskData->inputs_count, std::vector<uint32_t>({1000}));
+  EXPECT_EQ(taskData->outputs_count, std::vector<uint32_t>({2}));
+  EXPECT_EQ(taskData->input_as<int64_t>(0).data(), input.data());
+}
@@ -0,0 +1,106 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf_baseline.hpp"
+#include "core/perf/include/stats.hpp"
+
+namespace {
+
+std::vector<double> make_samples(double base, double step, size_t count) {
+  std::vector<double> samples;
+  for (size_t i = 0; i < count; i++) {
+    samples.push_back(base + step * static_cast<double>((i * 7) % count));
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST(perf_baseline_tests, check_mann_whitney) {
+  auto a = make_samples(1.0, 0.01, 30);
+  auto b = make_samples(1.0, 0.01, 30);
+  EXPECT_GT(ppc::core::stats::mann_whitney_p(a, b), 0.9);
+
+  auto shifted = make_samples(1.2, 0.01, 30);
+  EXPECT_LT(ppc::core::stats::mann_whitney_p(a, shifted), 1e-6);
+
+  std::vector<double> same(10, 1.0);
+  EXPECT_EQ(ppc::core::stats::mann_whitney_p(same, same), 1.0);
+  EXPECT_EQ(ppc::core::stats::mann_whitney_p(a, {}), 1.0);
+}
+
+TEST(perf_baseline_tests, check_student_t95) {
+  EXPECT_EQ(ppc::core::stats::student_t95(0), 0.0);
+  EXPECT_DOUBLE_EQ(ppc::core::stats::student_t95(10), 2.228);
+  EXPECT_DOUBLE_EQ(ppc::core::stats::student_t95(40), 2.021);
+  // exact values between rows of the table
+  EXPECT_NEAR(ppc::core::stats::student_t95(45), 2.014, 0.001);
+  EXPECT_NEAR(ppc::core::stats::student_t95(100), 1.984, 0.001);
+  EXPECT_NEAR(ppc::core::stats::student_t95(1000), 1.962, 0.001);
+  for (size_t dof = 1; dof < 1000; dof++) {
+    ASSERT_GE(ppc::core::stats::student_t95(dof), ppc::core::stats::student_t95(dof + 1));
+  }
+}
+
+TEST(perf_baseline_tests, check_compare_verdicts) {
+  using Verdict = ppc::core::BaselineComparison::Verdict;
+  auto baseline = make_samples(1.0, 0.01, 30);
+
+  auto unchanged = ppc::core::PerfBaseline::compare(baseline, make_samples(1.0, 0.01, 30));
+  EXPECT_EQ(unchanged.verdict, Verdict::UNCHANGED);
+  EXPECT_NEAR(unchanged.change, 0.0, 1e-12);
+
+  auto slower = ppc::core::PerfBaseline::compare(baseline, make_samples(1.5, 0.01, 30));
+  EXPECT_EQ(slower.verdict, Verdict::REGRESSION);
+  EXPECT_NEAR(slower.change, 0.5 / 1.145, 1e-9);
+
+  auto faster = ppc::core::PerfBaseline::compare(baseline, make_samples(0.5, 0.01, 30));
+  EXPECT_EQ(faster.verdict, Verdict::IMPROVEMENT);
+  EXPECT_LT(faster.change, 0.0);
+
+  EXPECT_EQ(ppc::core::PerfBaseline::compare({}, baseline).verdict, Verdict::NO_BASELINE);
+}
+
+TEST(perf_baseline_tests, check_store) {
+  auto path = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_test.tsv").string();
+  std::remove(path.c_str());
+
+  ppc::core::PerfResults results;
+  results.type_of_running = ppc::core::PerfResults::TypeOfRunning::TASK_RUN;
+  results.num_elements = 1000;
+  auto record = ppc::core::PerfWriter::make_record("/ppc/tasks/seq/example/perf_tests/main.cpp", results);
+  auto key = ppc::core::PerfBaseline::key(record);
+  record.results.num_elements = 2000;
+  EXPECT_NE(ppc::core::PerfBaseline::key(record), key);
+
+  {
+    ppc::core::PerfBaseline baseline(path);
+    EXPECT_EQ(baseline.find(key), nullptr);
+    baseline.update(key, {0.5, 0.25, 0.125});
+    baseline.save();
+  }
+  ppc::core::PerfBaseline baseline(path);
+  const auto *samples = baseline.find(key);
+  ASSERT_NE(samples, nullptr);
+  EXPECT_EQ(*samples, std::vector<double>({0.5, 0.25, 0.125}));
+
+  // Processes loaded the file before saves of each other
+  ppc::core::PerfBaseline first(path);
+  ppc::core::PerfBaseline second(path);
+  auto other_key = ppc::core::PerfBaseline::key(record);
+  first.update(key, {0.75});
+  second.update(other_key, {0.5});
+  first.save();
+  second.save();
+  ppc::core::PerfBaseline merged(path);
+  ASSERT_NE(merged.find(key), nullptr);
+  ASSERT_NE(merged.find(other_key), nullptr);
+  EXPECT_EQ(*merged.find(key), std::vector<double>({0.75}));
+  EXPECT_EQ(*merged.find(other_key), std::vector<double>({0.5}));
+  std::remove(path.c_str());
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/perf_compare.hpp"
+
+TEST(perf_compare_tests, check_compare_pipeline) {
+  // Create data: "parallel" task processes a quarter of the data
+  std::vector<uint32_t> in(400000, 1);
+  std::vector<uint32_t> out_seq(1, 0);
+  std::vector<uint32_t> out_par(1, 0);
+
+  // Create TaskData
+  auto taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataSeq->inputs_count.emplace_back(in.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_seq.data()));
+  taskDataSeq->outputs_count.emplace_back(out_seq.size());
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataPar->inputs_count.emplace_back(in.size() / 4);
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_par.data()));
+  taskDataPar->outputs_count.emplace_back(out_par.size());
+
+  // Create Tasks, runs take 4 ms and 1.6 ms of fake time
+  double clock = 0.0;
+  auto seqTask = std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskDataSeq, clock, std::vector<double>{0.004});
+  auto parTask = std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskDataPar, clock, std::vector<double>{0.0016});
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 20;
+  perfAttr->num_warmup = 2;
+  perfAttr->num_workers = 4;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init compare results
+  auto results = std::make_shared<ppc::core::CompareResults>();
+
+  // Create comparator
+  ppc::core::PerfCompare perfCompare(seqTask, parTask);
+  perfCompare.pipeline_run(perfAttr, results);
+
+  ASSERT_EQ(results->seq->samples_sec.size(), perfAttr->num_running);
+  ASSERT_EQ(results->par->samples_sec.size(), perfAttr->num_running);
+  EXPECT_EQ(results->num_workers, 4U);
+  EXPECT_NEAR(results->speedup, 2.5, 1e-9);
+  EXPECT_NEAR(results->efficiency, 0.625, 1e-9);
+  EXPECT_NEAR(results->serial_fraction, 0.2, 1e-9);
+  EXPECT_EQ(out_seq[0], in.size());
+  EXPECT_EQ(out_par[0], in.size() / 4);
+}
+
+TEST(perf_compare_tests, check_compare_task_run_without_seq_task) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto parTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+
+  // Create and init compare results
+  auto results = std::make_shared<ppc::core::CompareResults>();
+
+  // Create comparator
+  ppc::core::PerfCompare perfCompare(nullptr, parTask);
+  perfCompare.task_run(perfAttr, results);
+
+  EXPECT_TRUE(results->seq->samples_sec.empty());
+  EXPECT_EQ(results->par->samples_sec.size(), perfAttr->num_running);
+  EXPECT_EQ(results->speedup, 0.0);
+}
@@ -0,0 +1,58 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "core/arena/include/arena.hpp"
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/perf_sweep.hpp"
+
+TEST(perf_sweep_tests, check_strong_and_weak_scaling) {
+  ppc::core::BufferArena arena;
+  std::vector<std::shared_ptr<ppc::core::TaskData>> tasksData;
+
+  // "Parallel" task which processes size / num_workers elements, its run takes
+  // 10 ns of fake time per element and 0.1 ms of overhead
+  double clock = 0.0;
+  ppc::core::PerfSweep perfSweep([&](uint64_t size, uint64_t num_workers) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    auto in = arena.add_input<uint32_t>(*taskData, size);
+    arena.add_output<uint32_t>(*taskData, 1);
+    std::fill(in.begin(), in.end(), 1);
+    taskData->inputs_count[0] = size / num_workers;
+    tasksData.push_back(taskData);
+    auto run_time = 1e-8 * static_cast<double>(size / num_workers) + 0.0001;
+    return std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskData, clock, std::vector<double>{run_time});
+  });
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->current_timer = [&] { return clock; };
+
+  ppc::core::SweepAttr sweepAttr;
+  sweepAttr.workers = {1, 2, 4};
+  sweepAttr.strong_size = 400000;
+  sweepAttr.weak_size_per_worker = 100000;
+
+  ppc::core::SweepResults sweepResults;
+  perfSweep.run(perfAttr, sweepAttr, sweepResults);
+  auto flags = std::cout.flags();
+  auto precision = std::cout.precision();
+  ppc::core::PerfSweep::print_sweep_statistic(sweepResults);
+  EXPECT_EQ(std::cout.flags(), flags);
+  EXPECT_EQ(std::cout.precision(), precision);
+
+  ASSERT_EQ(sweepResults.strong.size(), 3U);
+  ASSERT_EQ(sweepResults.weak.size(), 3U);
+  EXPECT_EQ(sweepResults.strong[2].size, 400000U);
+  EXPECT_EQ(sweepResults.weak[2].size, 400000U);
+  EXPECT_EQ(sweepResults.strong[2].results->num_workers, 4U);
+  EXPECT_DOUBLE_EQ(sweepResults.strong[0].speedup, 1.0);
+  EXPECT_NEAR(sweepResults.strong[2].speedup, 0.0041 / 0.0011, 1e-6);
+  EXPECT_DOUBLE_EQ(sweepResults.strong[2].efficiency, sweepResults.strong[2].speedup / 4);
+  EXPECT_DOUBLE_EQ(sweepResults.weak[0].efficiency, 1.0);
+  EXPECT_NEAR(sweepResults.weak[2].efficiency, 1.0, 1e-6);
+}
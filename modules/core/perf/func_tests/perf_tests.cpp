@@ -1,10 +1,15 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iostream>
+#include <string>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/cache_flusher.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/roofline.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -155,3 +160,380 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_statistics) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 3;
+  // Every run takes one second except the last one
+  uint64_t timer_calls = 0;
+  double now = 0.0;
+  perfAttr->current_timer = [&] {
+    timer_calls++;
+    if (timer_calls % 2 == 0) now += timer_calls == 2 * perfAttr->num_running ? 100.0 : 1.0;
+    return now;
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  ASSERT_EQ(timer_calls, 2 * perfAttr->num_running);
+  ASSERT_EQ(perfResults->samples_sec.size(), perfAttr->num_running);
+  EXPECT_DOUBLE_EQ(perfResults->time_sec, 109.0);
+  EXPECT_DOUBLE_EQ(perfResults->min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->max_sec, 100.0);
+  EXPECT_DOUBLE_EQ(perfResults->median_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->mean_sec, 10.9);
+  EXPECT_LT(perfResults->ci_low_sec, perfResults->mean_sec);
+  EXPECT_GT(perfResults->ci_high_sec, perfResults->mean_sec);
+  EXPECT_EQ(perfResults->outliers_count, 0U);
+
+  // Repeat with rejection of outliers
+  timer_calls = 0;
+  perfAttr->reject_outliers = true;
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->outliers_count, 1U);
+  EXPECT_DOUBLE_EQ(perfResults->max_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->mean_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->stddev_sec, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_hw_counters) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->collect_hw_counters = true;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  // Counters may be unavailable, e.g. in containers
+  const auto &counters = perfResults->hw_counters;
+  if (counters.cycles && counters.instructions) {
+    EXPECT_GT(*counters.instructions, 0U);
+    EXPECT_GT(perfResults->ipc, 0.0);
+  } else {
+    EXPECT_EQ(perfResults->ipc, 0.0);
+  }
+  if (!ppc::core::HwCounters().available()) {
+    EXPECT_FALSE(counters.cycles.has_value());
+    EXPECT_FALSE(counters.llc_misses.has_value());
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_phases_time) {
+  // Create data
+  std::vector<uint32_t> in(200000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  const auto &phases_time = perfResults->phases_time_sec;
+  auto run_time = phases_time[static_cast<size_t>(ppc::core::Task::Phase::RUN)];
+  EXPECT_GT(run_time, 0.0);
+  for (auto phase_time : phases_time) {
+    EXPECT_GE(phase_time, 0.0);
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_comm_stats) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestCommTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 3;
+  double time = 0.0;
+  perfAttr->current_timer = [&] { return time += 0.01; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  // Only measured runs are accounted
+  using Phase = ppc::core::Task::Phase;
+  using ppc::core::CommOp;
+  const auto &comm_stats = perfResults->comm_stats;
+  EXPECT_EQ(comm_stats.at(Phase::PRE_PROCESSING, CommOp::BCAST).messages, 10U);
+  EXPECT_EQ(comm_stats.at(Phase::PRE_PROCESSING, CommOp::BCAST).bytes, 10 * in.size() * sizeof(uint32_t));
+  EXPECT_EQ(comm_stats.at(Phase::RUN, CommOp::REDUCE).messages, 10U);
+  EXPECT_EQ(comm_stats.phase_total(Phase::VALIDATION).messages, 0U);
+  EXPECT_EQ(comm_stats.total().messages, 20U);
+  EXPECT_NEAR(comm_stats.total().time_sec, 0.03, 1e-9);
+  EXPECT_NEAR(perfResults->comm_time_fraction, 0.3, 1e-6);
+}
+
+TEST(perf_tests, check_perf_calibration_to_target_time) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task, every run takes 1 ms of fake time
+  double clock = 0.0;
+  auto testTask = std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskData, clock, std::vector<double>{0.001});
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->target_time_sec = 0.5;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_EQ(perfResults->num_running, 500U);
+  EXPECT_EQ(perfResults->samples_sec.size(), 500U);
+  EXPECT_NEAR(perfResults->time_sec, 0.5, 1e-6);
+
+  // Counters are spread over the calibrated count of runs
+  perfResults->hw_counters.llc_misses = 100000;
+  ppc::core::Perf::calc_counters_metrics(perfResults);
+  EXPECT_EQ(perfResults->num_elements, in.size());
+  EXPECT_DOUBLE_EQ(perfResults->llc_misses_per_element, 2.0);
+
+  // Count of runs is limited
+  perfAttr->max_running = 100;
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->num_running, 100U);
+}
+
+TEST(perf_tests, check_perf_calibration_to_target_precision) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task, runs take 1 ms and 3 ms of fake time in turn
+  double clock = 0.0;
+  auto testTask =
+      std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskData, clock, std::vector<double>{0.001, 0.003});
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->target_precision = 0.05;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_GT(perfResults->num_running, 10U);
+  auto precision = (perfResults->ci_high_sec - perfResults->mean_sec) / perfResults->mean_sec;
+  EXPECT_LE(precision, 0.05);
+}
+
+TEST(perf_tests, check_perf_cold_cache_mode) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task, every run takes 1 ms of fake time
+  double clock = 0.0;
+  auto testTask = std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskData, clock, std::vector<double>{0.001});
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->cache_mode = ppc::core::CacheMode::COLD;
+  perfAttr->cache_flush_bytes = 1024 * 1024;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer, flushing is not measured
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->cache_mode, ppc::core::CacheMode::COLD);
+  EXPECT_EQ(perfResults->num_running, 10U);
+  EXPECT_NEAR(perfResults->time_sec, 0.01, 1e-9);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_cache_flusher_size) {
+  auto cache_size = ppc::core::CacheFlusher::largest_cache_size();
+  ppc::core::CacheFlusher flusher;
+  if (cache_size != 0) {
+    EXPECT_GE(flusher.size(), std::min<size_t>(2 * cache_size, 512 * 1024 * 1024));
+  } else {
+    EXPECT_GT(flusher.size(), 0U);
+  }
+  ppc::core::CacheFlusher small_flusher(4096);
+  EXPECT_EQ(small_flusher.size(), 4096U);
+  small_flusher.flush();
+}
+
+TEST(perf_tests, check_perf_roofline_metrics) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task, every run takes 1 ms of fake time and moves 1 MB
+  double clock = 0.0;
+  auto testTask = std::make_shared<ppc::test::TestClockTask<uint32_t>>(taskData, clock, std::vector<double>{0.001},
+                                                                       1000000, 2000000);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->bytes_per_run, 1000000U);
+  EXPECT_NEAR(perfResults->bandwidth_gbs, 1.0, 1e-9);
+  EXPECT_NEAR(perfResults->gflops, 2.0, 1e-9);
+
+  // Peaks are measured on request only
+  EXPECT_EQ(perfResults->peak_bandwidth_gbs, 0.0);
+  EXPECT_EQ(perfResults->roofline_efficiency, 0.0);
+
+  // Pipeline samples include other phases, rates use time of run phase
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  auto run_time = perfResults->phases_time_sec[static_cast<size_t>(ppc::core::Task::Phase::RUN)] /
+                  static_cast<double>(perfResults->num_running);
+  ASSERT_GT(run_time, 0.0);
+  EXPECT_NEAR(perfResults->bandwidth_gbs, 1000000.0 / run_time * 1e-9, 1e-9 * perfResults->bandwidth_gbs);
+}
+
+TEST(perf_tests, check_print_statistic_keeps_cout_format) {
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfResults->bandwidth_gbs = 1.0;
+  perfResults->comm_time_fraction = 0.5;
+
+  auto flags = std::cout.flags();
+  auto precision = std::cout.precision();
+  testing::internal::CaptureStdout();
+  ppc::core::Perf::print_roofline_statistic(perfResults);
+  ppc::core::Perf::print_comm_statistic(perfResults);
+  auto output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("roofline:1.000:"), std::string::npos);
+  EXPECT_NE(output.find("comm:fraction:0.5000"), std::string::npos);
+  EXPECT_EQ(std::cout.flags(), flags);
+  EXPECT_EQ(std::cout.precision(), precision);
+}
+
+TEST(perf_tests, check_roofline) {
+  EXPECT_GT(ppc::core::Roofline::measure_bandwidth(2, 1024 * 1024), 0.0);
+
+  ppc::core::MachinePeak machine_peak{10.0, 100.0};
+  // memory bound: attainable 0.5 op/byte * 10 GB/s = 5 GFLOP/s
+  EXPECT_NEAR(ppc::core::Roofline::efficiency(machine_peak, 2000000, 1000000, 0.001), 0.2, 1e-9);
+  // compute bound: attainable 100 GFLOP/s
+  EXPECT_NEAR(ppc::core::Roofline::efficiency(machine_peak, 1000, 50000000, 0.001), 0.5, 1e-9);
+  // bytes only
+  EXPECT_NEAR(ppc::core::Roofline::efficiency(machine_peak, 5000000, 0, 0.001), 0.5, 1e-9);
+}
@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "core/perf/include/perf_writer.hpp"
+
+TEST(perf_writer_tests, check_task_path) {
+  using ppc::core::PerfWriter;
+  EXPECT_EQ(PerfWriter::task_path("/home/user/ppc/tasks/mpi/example/perf_tests/main.cpp"), "tasks/mpi/example");
+  EXPECT_EQ(PerfWriter::task_path("C:\\work\\tasks\\seq\\my_tasks_sum\\perf_tests\\main.cpp"),
+            "tasks/seq/my_tasks_sum");
+  EXPECT_EQ(PerfWriter::task_path("/home/user/ppc/modules/core/perf/func_tests/perf_tests.cpp"), "");
+}
+
+TEST(perf_writer_tests, check_json_lines) {
+  ppc::core::PerfResults results;
+  results.type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  results.time_sec = 2.5;
+  results.num_elements = 120;
+  results.hw_counters.cycles = 1000;
+  results.ipc = std::numeric_limits<double>::quiet_NaN();
+  auto record = ppc::core::PerfWriter::make_record("/ppc/tasks/omp/example/perf_tests/main.cpp", results);
+  EXPECT_EQ(record.task_id, "example");
+  EXPECT_EQ(record.backend, "omp");
+
+  std::ostringstream out;
+  ppc::core::PerfWriter writer(out, ppc::core::PerfWriter::Format::JSON_LINES);
+  writer.write_header();
+  writer.write(record);
+  auto line = out.str();
+  EXPECT_EQ(line.front(), '{');
+  EXPECT_EQ(line.substr(line.size() - 2), "}\n");
+  EXPECT_NE(line.find("\"task_id\":\"example\""), std::string::npos);
+  EXPECT_NE(line.find("\"type_of_running\":\"pipeline\""), std::string::npos);
+  EXPECT_NE(line.find("\"num_elements\":120"), std::string::npos);
+  EXPECT_NE(line.find("\"time_sec\":2.5"), std::string::npos);
+  EXPECT_NE(line.find("\"cycles\":1000"), std::string::npos);
+  EXPECT_NE(line.find("\"instructions\":null"), std::string::npos);
+  // nan isn't valid JSON
+  EXPECT_NE(line.find("\"ipc\":null"), std::string::npos);
+}
+
+TEST(perf_writer_tests, check_csv) {
+  ppc::core::PerfResults results;
+  auto record = ppc::core::PerfWriter::make_record("/ppc/tasks/stl/example/perf_tests/main.cpp", results);
+  record.cpu_model = "CPU, \"fast\"";
+
+  std::ostringstream out;
+  ppc::core::PerfWriter writer(out, ppc::core::PerfWriter::Format::CSV);
+  writer.write_header();
+  writer.write(record);
+
+  std::istringstream lines(out.str());
+  std::string header;
+  std::string line;
+  std::getline(lines, header);
+  std::getline(lines, line);
+  EXPECT_EQ(header.rfind("task_id,backend,type_of_running,", 0), 0U);
+  EXPECT_EQ(line.rfind("example,stl,none,", 0), 0U);
+  EXPECT_NE(line.find(",\"CPU, \"\"fast\"\"\","), std::string::npos);
+}
@@ -6,8 +6,10 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "core/perf/include/comm_stats.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::test {
@@ -47,6 +49,65 @@ class TestTask : public ppc::core::Task {
   T *output_{};
 };
 
+// Task which accounts communication like the PMPI profiling layer does: one
+// broadcast of input in pre_processing and one reduce of result in run
+template <class T>
+class TestCommTask : public TestTask<T> {
+ public:
+  explicit TestCommTask(std::shared_ptr<ppc::core::TaskData> taskData_) : TestTask<T>(taskData_) {}
+  bool pre_processing() override {
+    auto result = TestTask<T>::pre_processing();
+    ppc::core::CommStats::record(ppc::core::CommOp::BCAST, this->taskData->inputs_count[0] * sizeof(T), 0.001);
+    return result;
+  }
+
+  bool run() override {
+    auto result = TestTask<T>::run();
+    ppc::core::CommStats::record(ppc::core::CommOp::REDUCE, sizeof(T), 0.002);
+    return result;
+  }
+};
+
+// Task which advances fake clock by the next of run_times on every run and
+// declares given bytes and operations per run
+template <class T>
+class TestClockTask : public TestTask<T> {
+ public:
+  TestClockTask(std::shared_ptr<ppc::core::TaskData> taskData_, double &clock_, std::vector<double> run_times_,
+                uint64_t bytes_ = 0, uint64_t ops_ = 0)
+      : TestTask<T>(taskData_), clock(clock_), run_times(std::move(run_times_)), bytes(bytes_), ops(ops_) {}
+  bool run() override {
+    clock += run_times[runs_count++ % run_times.size()];
+    return TestTask<T>::run();
+  }
+  [[nodiscard]] uint64_t bytes_per_run() const override { return bytes; }
+  [[nodiscard]] uint64_t ops_per_run() const override { return ops; }
+
+ private:
+  double &clock;
+  std::vector<double> run_times;
+  uint64_t bytes;
+  uint64_t ops;
+  size_t runs_count = 0;
+};
+
+// Task which allocates a copy of input on every run
+template <class T>
+class TestAllocTask : public TestTask<T> {
+ public:
+  explicit TestAllocTask(std::shared_ptr<ppc::core::TaskData> taskData_) : TestTask<T>(taskData_) {}
+  bool run() override {
+    auto result = TestTask<T>::run();
+    auto *input = reinterpret_cast<T *>(this->taskData->inputs[0]);
+    // copy of the previous run is freed here
+    copy_ = std::vector<T>(input, input + this->taskData->inputs_count[0]);
+    return result;
+  }
+
+ private:
+  std::vector<T> copy_;
+};
+
 }  // namespace ppc::test
 
 #endif  // MODULES_CORE_TESTS_TEST_TASK_HPP_
@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ppc::core {
+
+// Placement of workers (threads or MPI ranks of a node) on CPUs:
+// COMPACT fills hardware threads of one core, then the next core;
+// SCATTER spreads workers over packages and cores first;
+// PHYSICAL_CORES uses one hardware thread of every core;
+// EXPLICIT uses the given list of CPUs.
+enum class AffinityPolicy : uint8_t { NONE, COMPACT, SCATTER, PHYSICAL_CORES, EXPLICIT };
+
+struct CpuInfo {
+  int cpu = 0;
+  int package = 0;
+  // index of core in its package
+  int core = 0;
+  // index of hardware thread in its core
+  int smt = 0;
+};
+
+// CPU affinity on Linux, other systems are left to the OS scheduler
+class Affinity {
+ public:
+  // CPUs available to the process, empty if they can't be detected
+  static std::vector<CpuInfo> topology();
+
+  // CPUs in the order workers are placed on them
+  static std::vector<int> placement(AffinityPolicy policy, const std::vector<int>& explicit_cpus = {});
+
+  // policy used by pin_worker()
+  static void set_policy(AffinityPolicy policy, const std::vector<int>& explicit_cpus = {});
+  static AffinityPolicy get_policy();
+
+  // Pin the calling thread to CPU of worker with index. Backends call it from
+  // their threads (see affinity_omp.hpp and affinity_tbb.hpp); MPI ranks of a
+  // node take indices by local rank. With policy NONE the thread gets all CPUs
+  // of the process back. Returns false if nothing was pinned.
+  static bool pin_worker(size_t worker_index);
+
+  // pin the calling thread to cpu
+  static bool pin_thread(int cpu);
+
+  // index of MPI process on its node from launcher environment, 0 otherwise
+  static size_t local_rank();
+
+  static const char* policy_name(AffinityPolicy policy);
+};
+
+// Applies policy for its lifetime: the calling thread is pinned as worker of
+// local rank, its previous CPU mask and previous policy are restored at the end.
+// Threads of backends are pinned by pin_workers (see PerfAttr::pin_workers)
+// after the policy is applied and after it is restored, so they don't keep CPUs
+// of the scope.
+class ScopedAffinity {
+ public:
+  ScopedAffinity(AffinityPolicy policy, const std::vector<int>& explicit_cpus,
+                 std::function<void()> pin_workers_ = {});
+  ScopedAffinity(const ScopedAffinity&) = delete;
+  ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+  ~ScopedAffinity();
+
+ private:
+  bool is_active;
+  std::function<void()> pin_workers;
+  AffinityPolicy previous_policy = AffinityPolicy::NONE;
+  std::vector<int> previous_placement;
+  // CPU mask of the calling thread
+  std::vector<int> thread_cpus;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_HPP_
@@ -0,0 +1,23 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
+
+#include <omp.h>
+
+#include "core/perf/include/affinity.hpp"
+
+// Pinning of OpenMP threads. This header is used only by OpenMP tests, so core
+// library itself doesn't depend on OpenMP.
+namespace ppc::core {
+
+// Pin threads of OpenMP team by current policy, the runtime reuses them in
+// next parallel regions of the same size. It is used as PerfAttr::pin_workers.
+inline void pin_omp_threads() {
+#pragma omp parallel
+  Affinity::pin_worker(static_cast<size_t>(omp_get_thread_num()));
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
@@ -0,0 +1,30 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
+
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+
+#include "core/perf/include/affinity.hpp"
+
+// Pinning of TBB threads. This header is used only by TBB tests, so core
+// library itself doesn't depend on TBB.
+namespace ppc::core {
+
+// Pins every thread entering the task arena by current policy while it exists
+class TbbAffinityObserver : public tbb::task_scheduler_observer {
+ public:
+  TbbAffinityObserver() { observe(true); }
+  TbbAffinityObserver(const TbbAffinityObserver &) = delete;
+  TbbAffinityObserver &operator=(const TbbAffinityObserver &) = delete;
+  ~TbbAffinityObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    Affinity::pin_worker(static_cast<size_t>(tbb::this_task_arena::current_thread_index()));
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
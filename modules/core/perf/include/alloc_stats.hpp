@@ -0,0 +1,52 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ALLOC_STATS_HPP_
+#define MODULES_CORE_INCLUDE_ALLOC_STATS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct AllocPhaseStats {
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  uint64_t allocated_bytes = 0;
+  // maximum of bytes allocated and not freed by the process during the phase
+  uint64_t peak_live_bytes = 0;
+};
+
+// Statistics of heap allocations made through operator new
+struct AllocStats {
+  // validation, pre_processing, run, post_processing and calls outside of tasks
+  constexpr static size_t phases_count = 5;
+
+  std::array<AllocPhaseStats, phases_count> phases{};
+
+  [[nodiscard]] const AllocPhaseStats& at(Task::Phase phase) const { return phases[static_cast<size_t>(phase)]; }
+  // sum over phases, peak is the maximum of phases
+  [[nodiscard]] AllocPhaseStats total() const;
+  // counts since the snapshot, peaks are kept
+  [[nodiscard]] AllocStats since(const AllocStats& snapshot) const;
+
+  // Statistics of the process, counted by the operator new/delete interposer
+  // from modules/core/perf/alloc which is linked into executables on request
+  // (USE_ALLOC_PROFILER). They stay empty otherwise.
+  static AllocStats snapshot();
+  // true if the interposer is linked
+  static bool enabled();
+  // start peaks of all phases from bytes live now
+  static void reset_peaks();
+
+  // Called by the interposer
+  static void record_allocation(size_t size);
+  static void record_deallocation(size_t size);
+  static void mark_enabled();
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ALLOC_STATS_HPP_
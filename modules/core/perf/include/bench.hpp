@@ -0,0 +1,140 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BENCH_HPP_
+#define MODULES_CORE_INCLUDE_BENCH_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Owner of input and output buffers of one benchmark case and of TaskData
+// pointing to them
+class BenchData {
+ public:
+  BenchData();
+
+  // add zero initialized input or output of count elements
+  template <class T>
+  std::span<T> add_input(size_t count) {
+    return add_buffer<T>(taskData->inputs, taskData->inputs_count, count);
+  }
+  template <class T>
+  std::span<T> add_output(size_t count) {
+    return add_buffer<T>(taskData->outputs, taskData->outputs_count, count);
+  }
+
+  [[nodiscard]] std::shared_ptr<TaskData> task_data() const { return taskData; }
+
+  // fill values with reproducible pseudo-random numbers from [low, high]
+  template <class T>
+  static void fill_random(std::span<T> values, T low, T high, uint64_t seed = 42) {
+    std::mt19937_64 generator(seed);
+    if constexpr (std::is_floating_point_v<T>) {
+      std::uniform_real_distribution<T> distribution(low, high);
+      for (auto &value : values) value = distribution(generator);
+    } else {
+      std::uniform_int_distribution<T> distribution(low, high);
+      for (auto &value : values) value = distribution(generator);
+    }
+  }
+
+ private:
+  template <class T>
+  std::span<T> add_buffer(std::vector<uint8_t *> &pointers, std::vector<uint32_t> &counts, size_t count) {
+    auto &buffer = buffers.emplace_back(count * sizeof(T));
+    pointers.push_back(buffer.data());
+    counts.push_back(static_cast<uint32_t>(count));
+    return {reinterpret_cast<T *>(buffer.data()), count};
+  }
+
+  std::vector<std::vector<uint8_t>> buffers;
+  std::shared_ptr<TaskData> taskData;
+};
+
+struct BenchOptions {
+  // regular expression searched in "<name>/<size>" of benchmarks to run
+  std::string filter = ".*";
+  // calibrated measured time of every benchmark in seconds
+  double min_time_sec = 0.1;
+};
+
+struct BenchResult {
+  std::string name;
+  // count of elements of input
+  uint64_t size = 0;
+  std::shared_ptr<PerfResults> results;
+  // elements of input processed per second by median run
+  double elements_per_sec = 0.0;
+};
+
+// Registry of benchmarks of run() of tasks in the style of Google Benchmark.
+// Every benchmark is measured for sizes of input from L1-resident to
+// DRAM-resident ones.
+class Bench {
+ public:
+  // creates task over data with size elements of input
+  using CaseFactory = std::function<std::shared_ptr<Task>(BenchData &data, uint64_t size)>;
+
+  // register benchmark, element_size is size of one element of input in bytes;
+  // returns true, so it can initialize a static variable
+  static bool add(const std::string &name, size_t element_size, CaseFactory factory);
+
+  // register benchmark "<name><type>" for every type of Types; factory is
+  // called with std::type_identity<type> as the first argument
+  template <class... Types, class Factory>
+  static bool add_for_types(const std::string &name, Factory factory) {
+    auto add_type = [&](auto type) {
+      using T = typename decltype(type)::type;
+      return add(name + "<" + type_name<T>() + ">", sizeof(T),
+                 [factory](BenchData &data, uint64_t size) { return factory(std::type_identity<T>{}, data, size); });
+    };
+    return (add_type(std::type_identity<Types>{}) && ...);
+  }
+
+  // counts of elements of input which fit L1, L2 and the last level cache and
+  // the one which exceeds it
+  static std::vector<uint64_t> sizes(size_t element_size);
+
+  // run registered benchmarks selected by options, print
+  // "bench:<name>/<size>:<median time>:<elements/s>:<GB/s>" lines to out
+  static std::vector<BenchResult> run(const BenchOptions &options, std::ostream &out);
+
+  // run with options from --benchmark_filter=<regex> and
+  // --benchmark_min_time=<seconds> arguments, 1 on invalid arguments
+  static int main(int argc, char **argv);
+
+  // name of element type in names of benchmarks, e.g. "int32_t"
+  template <class T>
+  static std::string type_name() {
+    if constexpr (std::is_same_v<T, float>) {
+      return "float";
+    } else if constexpr (std::is_same_v<T, double>) {
+      return "double";
+    } else {
+      return (std::is_signed_v<T> ? "int" : "uint") + std::to_string(8 * sizeof(T)) + "_t";
+    }
+  }
+
+ private:
+  struct Entry {
+    std::string name;
+    size_t element_size;
+    CaseFactory factory;
+  };
+  static std::vector<Entry> &registry();
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BENCH_HPP_
@@ -0,0 +1,37 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_CACHE_FLUSHER_HPP_
+#define MODULES_CORE_INCLUDE_CACHE_FLUSHER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Evicts data of the task from CPU caches by streaming over a scratch buffer
+// larger than the caches
+class CacheFlusher {
+ public:
+  // size of buffer in bytes, twice the largest cache if 0
+  explicit CacheFlusher(size_t size_ = 0);
+
+  void flush();
+
+  [[nodiscard]] size_t size() const { return buffer.size(); }
+
+  // size of the largest CPU cache from sysfs in bytes, 0 if it's unknown
+  static size_t largest_cache_size();
+
+ private:
+  // limits of size of buffer for unknown and very large caches
+  static constexpr size_t default_size = 64 * 1024 * 1024;
+  static constexpr size_t max_size = 512 * 1024 * 1024;
+  static constexpr size_t cache_line_size = 64;
+
+  std::vector<uint8_t> buffer;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_CACHE_FLUSHER_HPP_
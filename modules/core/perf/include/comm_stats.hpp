@@ -0,0 +1,55 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COMM_STATS_HPP_
+#define MODULES_CORE_INCLUDE_COMM_STATS_HPP_
+
+#include <array>
+#include <cstdint>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// WAIT is time of completion and probe calls (MPI_Wait*, MPI_Test*, MPI_Probe,
+// MPI_Iprobe), it has no messages of its own
+enum class CommOp : uint8_t { SEND, RECV, BCAST, SCATTER, GATHER, REDUCE, WAIT };
+
+struct CommOpStats {
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  // time spent inside of communication calls (in seconds)
+  double time_sec = 0.0;
+};
+
+// Communication statistics of the process
+struct CommStats {
+  constexpr static size_t ops_count = 7;
+  // validation, pre_processing, run, post_processing and calls outside of tasks
+  constexpr static size_t phases_count = 5;
+
+  std::array<std::array<CommOpStats, ops_count>, phases_count> ops{};
+
+  CommOpStats& at(Task::Phase phase, CommOp op) { return ops[static_cast<size_t>(phase)][static_cast<size_t>(op)]; }
+  [[nodiscard]] const CommOpStats& at(Task::Phase phase, CommOp op) const {
+    return ops[static_cast<size_t>(phase)][static_cast<size_t>(op)];
+  }
+  // sum over all operations of the phase
+  [[nodiscard]] CommOpStats phase_total(Task::Phase phase) const;
+  // sum over all phases and operations
+  [[nodiscard]] CommOpStats total() const;
+  // statistics gathered since the snapshot
+  [[nodiscard]] CommStats since(const CommStats& snapshot) const;
+
+  // Statistics of the process, filled by the PMPI profiling layer from
+  // modules/core/perf/pmpi which is linked into MPI perf tests only. It stays
+  // empty in other executables.
+  static CommStats& global();
+  // Account a call of op in the phase being executed by the process; messages
+  // is 0 for bytes of a message which was posted before, e.g. by MPI_Irecv
+  static void record(CommOp op, uint64_t bytes, double time_sec, uint64_t messages = 1);
+  static const char* op_name(CommOp op);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_COMM_STATS_HPP_
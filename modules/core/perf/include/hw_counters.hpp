@@ -0,0 +1,59 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
+#define MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace ppc::core {
+
+// Values of hardware performance counters. A counter is empty if it can't be
+// used on this system (not Linux, no PMU access in a container, etc.)
+struct HwCountersValues {
+  std::optional<uint64_t> cycles;
+  std::optional<uint64_t> instructions;
+  std::optional<uint64_t> llc_misses;
+  std::optional<uint64_t> branch_misses;
+  std::optional<uint64_t> dtlb_misses;
+};
+
+// Hardware performance counters of the calling thread opened with
+// perf_event_open as one group, so all of them count over the same time and
+// are scaled together if the kernel multiplexes them. Threads created after
+// opening are counted after they finish; threads which existed before
+// opening (workers of OpenMP, TBB or ThreadPool created by earlier runs) and
+// threads which are still alive at stop() aren't counted, so for threaded
+// backends the values cover the calling thread only. In MPI each rank counts
+// its own process.
+class HwCounters {
+ public:
+  HwCounters();
+  HwCounters(const HwCounters &) = delete;
+  HwCounters &operator=(const HwCounters &) = delete;
+  ~HwCounters();
+
+  // true if at least one counter can be used
+  [[nodiscard]] bool available() const;
+
+  // reset and start counting
+  void start();
+
+  // exclude work between pause() and resume() from counting
+  void pause();
+  void resume();
+
+  // stop counting and read values
+  HwCountersValues stop();
+
+ private:
+  static constexpr size_t counters_count = 5;
+  std::array<int, counters_count> fds;
+  int leader_fd = -1;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
@@ -3,25 +3,127 @@
 #ifndef MODULES_CORE_INCLUDE_PERF_HPP_
 #define MODULES_CORE_INCLUDE_PERF_HPP_
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
 
+#include "core/perf/include/affinity.hpp"
+#include "core/perf/include/alloc_stats.hpp"
+#include "core/perf/include/comm_stats.hpp"
+#include "core/perf/include/hw_counters.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
 namespace core {
 
+// Warm mode measures runs on data left in caches by previous runs, cold mode
+// flushes caches before every measured run
+enum class CacheMode : uint8_t { WARM, COLD };
+
 struct PerfAttr {
   // count of task's running
   uint64_t num_running;
+  // count of task's running before measurement
+  uint64_t num_warmup = 0;
+  // exclude runs outside of Tukey's fences from statistics
+  bool reject_outliers = false;
+  // collect hardware performance counters of measured runs; they count the
+  // calling thread and threads started and finished by the runs, but not
+  // persistent workers of threaded backends (see HwCounters)
+  bool collect_hw_counters = false;
+  // state of CPU caches before measured runs; hardware counters are paused
+  // while caches are flushed
+  CacheMode cache_mode = CacheMode::WARM;
+  // size of buffer flushing caches in bytes, twice the largest cache if 0
+  size_t cache_flush_bytes = 0;
+  // placement of threads and MPI processes on CPUs during measurement
+  AffinityPolicy affinity = AffinityPolicy::NONE;
+  // CPUs for AffinityPolicy::EXPLICIT
+  std::vector<int> affinity_cpus;
+  // called after the policy is applied and after it is restored to pin threads
+  // of backend, e.g. ppc::core::pin_omp_threads or ThreadPool::pin_workers()
+  std::function<void()> pin_workers;
+  // measure peaks of the machine and report roofline metrics of tasks which
+  // declare bytes_per_run() or ops_per_run()
+  bool roofline = false;
+  // count of elements processed by one run, sum of task's inputs_count if 0
+  uint64_t num_elements = 0;
+  // count of threads or processes running the task, detected from environment if
+  // 0 (see Perf::detect_num_workers()); thread backends set it themselves
+  uint64_t num_workers = 0;
+  // target of total measured time (in seconds); if it is positive count of
+  // runs is calibrated to reach it instead of using num_running
+  double target_time_sec = 0.0;
+  // target of relative half-width of 95% confidence interval of mean time; if
+  // it is positive runs are added till it is reached
+  double target_precision = 0.0;
+  // limits of calibrated count of runs
+  uint64_t min_running = 1;
+  uint64_t max_running = 100000;
+  // counts chosen by calibration must be the same on all processes, e.g. MPI
+  // tests set it to maximum over processes
+  std::function<uint64_t(uint64_t)> reduce_count = [](uint64_t count) { return count; };
   std::function<double(void)> current_timer = [&] { return 0.0; };
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
+  // measurement of time of each run (in seconds)
+  std::vector<double> samples_sec;
+  // statistics of time of one run (in seconds)
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+  double median_sec = 0.0;
+  double p95_sec = 0.0;
+  double p99_sec = 0.0;
+  double stddev_sec = 0.0;
+  // 95% confidence interval of mean time of one run (in seconds)
+  double ci_low_sec = 0.0;
+  double ci_high_sec = 0.0;
+  // count of runs excluded from statistics as outliers
+  uint64_t outliers_count = 0;
+  // count of elements processed by one run
+  uint64_t num_elements = 0;
+  // count of threads or processes running the task
+  uint64_t num_workers = 0;
+  // count of measured runs
+  uint64_t num_running = 0;
+  CacheMode cache_mode = CacheMode::WARM;
+  AffinityPolicy affinity = AffinityPolicy::NONE;
+  // roofline metrics of run: bytes and operations declared by task, achieved
+  // rates, peaks of the machine for num_workers threads and part of attainable
+  // performance reached; time of run is the median sample in TASK_RUN mode and
+  // mean time of run phase in PIPELINE mode
+  uint64_t bytes_per_run = 0;
+  uint64_t ops_per_run = 0;
+  double bandwidth_gbs = 0.0;
+  double gflops = 0.0;
+  double peak_bandwidth_gbs = 0.0;
+  double peak_gflops = 0.0;
+  double roofline_efficiency = 0.0;
+  // time of each phase of task (validation, pre_processing, run,
+  // post_processing) summed over measured runs (in seconds)
+  std::array<double, 4> phases_time_sec{};
+  // hardware performance counters of all measured runs
+  HwCountersValues hw_counters;
+  // instructions per cycle
+  double ipc = 0.0;
+  // counts of misses per processed element
+  double llc_misses_per_element = 0.0;
+  double branch_misses_per_element = 0.0;
+  double dtlb_misses_per_element = 0.0;
+  // MPI communication of measured runs per phase of task, empty if the PMPI
+  // profiling layer isn't linked
+  CommStats comm_stats;
+  // part of measured time spent in communication calls
+  double comm_time_fraction = 0.0;
+  // heap allocations of measured runs per phase of task, empty if the
+  // allocation profiler isn't linked
+  AllocStats alloc_stats;
   enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
   constexpr const static double MAX_TIME = 10.0;
 };
@@ -41,11 +143,33 @@ class Perf {
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Pint results for automation checkers
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Print allocation statistics as "alloc:<phase>:<allocations>:<bytes>:<peak live bytes>" lines
+  static void print_alloc_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Print roofline metrics as "roofline:<GB/s>:<peak GB/s>:<GFLOP/s>:<peak GFLOP/s>:<efficiency>" line
+  static void print_roofline_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Print communication statistics as "comm:<phase>:<op>:<messages>:<bytes>:<time>" lines
+  static void print_comm_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Calculate IPC and counters per element of perfResults->hw_counters over
+  // perfResults->num_running runs
+  static void calc_counters_metrics(const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Calculate statistics of perfResults->samples_sec
+  static void calc_statistics(const std::shared_ptr<PerfAttr>& perfAttr,
+                              const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Count of MPI processes set by launcher or OMP_NUM_THREADS, otherwise 1
+  static uint64_t detect_num_workers();
 
  private:
   std::shared_ptr<Task> task;
+  // after_pipeline is called after every run of pipeline outside of measured time
   static void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
-                         const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+                         const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                         const std::function<void()>& after_pipeline = {});
+  static uint64_t calibrate_running(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<double()>& measure);
+  static void add_precision_runs(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<double()>& measure,
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  void add_phases_time(const std::shared_ptr<ppc::core::PerfResults>& perfResults, Task::TimePoint pipeline_end) const;
+  void calc_task_metrics(const std::shared_ptr<PerfAttr>& perfAttr,
+                         const std::shared_ptr<ppc::core::PerfResults>& perfResults) const;
 };
 
 }  // namespace core
@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
+#define MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf_writer.hpp"
+
+namespace ppc::core {
+
+struct BaselineComparison {
+  enum class Verdict { NO_BASELINE, UNCHANGED, REGRESSION, IMPROVEMENT } verdict = Verdict::NO_BASELINE;
+  // relative change of median time of one run, positive if task became slower
+  double change = 0.0;
+  // p-value of Mann-Whitney U test
+  double p_value = 1.0;
+};
+
+// Local store of samples of previous runs. Every line of the file holds tab
+// separated task_id, backend, type of running, count of elements, machine
+// fingerprint (CPU model and count of cores) and space separated samples.
+// Processes of parallel test runs (ctest -j) may update it: save() writes a
+// temporary file and renames it, so readers never see a partial file.
+class PerfBaseline {
+ public:
+  // load baseline from path if the file exists
+  explicit PerfBaseline(std::string path_);
+
+  // key of results of record in the baseline
+  static std::string key(const PerfRecord &record);
+
+  // samples stored for key, nullptr if there are none
+  [[nodiscard]] const std::vector<double> *find(const std::string &key) const;
+
+  void update(const std::string &key, const std::vector<double> &samples);
+
+  // merge updated entries into the current content of the file and replace
+  // it; updates of other processes between the reading and the renaming of
+  // the file are lost
+  void save() const;
+
+  // Change is significant if p-value is less than alpha and median time
+  // changed by more than min_change
+  static BaselineComparison compare(const std::vector<double> &baseline, const std::vector<double> &samples,
+                                    double alpha = 0.01, double min_change = 0.02);
+
+  static const char *verdict_name(BaselineComparison::Verdict verdict);
+
+ private:
+  using Entries = std::map<std::string, std::vector<double>>;
+  static Entries load(const std::string &path);
+
+  std::string path;
+  Entries entries;
+  std::set<std::string> updated_keys;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
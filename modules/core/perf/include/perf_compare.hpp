@@ -0,0 +1,50 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_COMPARE_HPP_
+#define MODULES_CORE_INCLUDE_PERF_COMPARE_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct CompareResults {
+  // measurements of sequential and parallel tasks
+  std::shared_ptr<PerfResults> seq = std::make_shared<PerfResults>();
+  std::shared_ptr<PerfResults> par = std::make_shared<PerfResults>();
+  // count of threads or processes of parallel task
+  uint64_t num_workers = 0;
+  // ratio of median times of sequential and parallel tasks
+  double speedup = 0.0;
+  // speedup divided by count of workers
+  double efficiency = 0.0;
+  // experimentally determined serial fraction (Karp-Flatt metric), 0 for one worker
+  double serial_fraction = 0.0;
+};
+
+// Measurement of sequential and parallel implementations of one problem in the
+// same process. Runs of the tasks are interleaved (seq, par, par, seq, ...), so
+// drift of machine state affects both of them equally.
+class PerfCompare {
+ public:
+  // Sequential task may be nullptr on MPI processes which don't run it
+  PerfCompare(std::shared_ptr<Task> seq_task_, std::shared_ptr<Task> par_task_);
+  // Compare full pipelines of tasks
+  void pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<CompareResults>& results);
+  // Compare run() functions of tasks
+  void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<CompareResults>& results);
+
+ private:
+  std::shared_ptr<Task> seq_task;
+  std::shared_ptr<Task> par_task;
+  void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void(Task&)>& pipeline,
+                  const std::shared_ptr<CompareResults>& results);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_COMPARE_HPP_
@@ -0,0 +1,100 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+#define MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/trace/include/trace.hpp"
+
+// Reduction of Perf results over MPI processes. This header is used only by
+// MPI tests, so core library itself doesn't depend on MPI.
+namespace ppc::core {
+
+struct RanksTime {
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+  // max / mean, 1 for perfectly balanced load
+  double imbalance = 1.0;
+  int slowest_rank = 0;
+};
+
+struct MpiPerfResults {
+  // validation, pre_processing, run, post_processing
+  std::array<RanksTime, 4> phases;
+  // whole measured time
+  RanksTime total;
+};
+
+// Collect times of phases of all processes, result is the same on every process
+inline void reduce_perf_results(const boost::mpi::communicator& world, const PerfResults& perfResults,
+                                MpiPerfResults& mpiResults) {
+  constexpr size_t values_count = 5;
+  std::array<double, values_count> local_values{};
+  for (size_t i = 0; i < perfResults.phases_time_sec.size(); i++) {
+    local_values[i] = perfResults.phases_time_sec[i];
+  }
+  local_values[values_count - 1] = perfResults.time_sec;
+
+  std::vector<double> all_values(values_count * world.size());
+  boost::mpi::all_gather(world, local_values.data(), static_cast<int>(values_count), all_values.data());
+
+  for (size_t j = 0; j < values_count; j++) {
+    auto& ranks_time = j < mpiResults.phases.size() ? mpiResults.phases[j] : mpiResults.total;
+    ranks_time = RanksTime{all_values[j], all_values[j], 0.0, 1.0, 0};
+    for (int rank = 0; rank < world.size(); rank++) {
+      auto value = all_values[rank * values_count + j];
+      ranks_time.mean_sec += value;
+      if (value < ranks_time.min_sec) ranks_time.min_sec = value;
+      if (value > ranks_time.max_sec) {
+        ranks_time.max_sec = value;
+        ranks_time.slowest_rank = rank;
+      }
+    }
+    ranks_time.mean_sec /= world.size();
+    if (ranks_time.mean_sec > 0.0) ranks_time.imbalance = ranks_time.max_sec / ranks_time.mean_sec;
+  }
+}
+
+// Print "ranks:<phase>:max:min:mean:imbalance:slowest_rank" lines
+inline void print_mpi_perf_statistic(const MpiPerfResults& mpiResults) {
+  const std::array<std::string, 4> names = {"validation", "pre_processing", "run", "post_processing"};
+  auto print = [](const std::string& name, const RanksTime& ranks_time) {
+    std::ostringstream ranks_str;
+    ranks_str << "ranks:" << name << ":" << std::fixed << std::setprecision(10) << ranks_time.max_sec << ":"
+              << ranks_time.min_sec << ":" << ranks_time.mean_sec << ":" << std::setprecision(4)
+              << ranks_time.imbalance << ":" << ranks_time.slowest_rank;
+    std::cout << ranks_str.str() << std::endl;
+  };
+  for (size_t i = 0; i < names.size(); i++) {
+    print(names[i], mpiResults.phases[i]);
+  }
+  print("total", mpiResults.total);
+}
+
+// Gather events recorded by tracers of all processes and write one trace to
+// path on process 0
+inline void write_mpi_trace(const boost::mpi::communicator& world, const std::string& path) {
+  std::ostringstream events_chunk;
+  Tracer::instance().write_events(events_chunk);
+  std::vector<std::string> events_chunks;
+  boost::mpi::gather(world, events_chunk.str(), events_chunks, 0);
+  if (world.rank() == 0) {
+    std::ofstream output(path);
+    Tracer::write_trace(output, events_chunks);
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_MPI_HPP_
@@ -0,0 +1,66 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_SWEEP_HPP_
+#define MODULES_CORE_INCLUDE_PERF_SWEEP_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct SweepAttr {
+  // counts of threads or processes, the first one is the base of speedup
+  std::vector<uint64_t> workers = {1};
+  // input size for strong scaling, 0 to skip it
+  uint64_t strong_size = 0;
+  // input size per worker for weak scaling, 0 to skip it
+  uint64_t weak_size_per_worker = 0;
+  PerfResults::TypeOfRunning type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+};
+
+struct SweepPoint {
+  uint64_t size = 0;
+  uint64_t num_workers = 0;
+  std::shared_ptr<PerfResults> results;
+  // speedup relative to the first point of the curve
+  double speedup = 0.0;
+  // strong scaling: speedup per worker relative to the first point,
+  // weak scaling: ratio of time of the first point to time of this one
+  double efficiency = 0.0;
+};
+
+struct SweepResults {
+  std::vector<SweepPoint> strong;
+  std::vector<SweepPoint> weak;
+};
+
+// Driver of strong and weak scaling measurements. For every point of the sweep
+// the factory creates a task for given input size and count of workers; it is
+// responsible for applying the count (omp_set_num_threads(),
+// ThreadPool::resize(), tbb::global_control, MPI sub-communicator). The factory
+// returns nullptr on processes which don't take part in the point.
+class PerfSweep {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(uint64_t size, uint64_t num_workers)>;
+
+  explicit PerfSweep(TaskFactory factory_);
+  // Measure strong and weak scaling curves
+  void run(const std::shared_ptr<PerfAttr>& perfAttr, const SweepAttr& sweepAttr, SweepResults& sweepResults);
+  // Print curves as "<curve>:<size>:<workers>:<median time>:<speedup>:<efficiency>" lines
+  static void print_sweep_statistic(const SweepResults& sweepResults);
+
+ private:
+  TaskFactory factory;
+  std::vector<SweepPoint> run_curve(const std::shared_ptr<PerfAttr>& perfAttr, const SweepAttr& sweepAttr,
+                                    bool is_weak);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_SWEEP_HPP_
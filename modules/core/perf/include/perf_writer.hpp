@@ -0,0 +1,67 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_WRITER_HPP_
+#define MODULES_CORE_INCLUDE_PERF_WRITER_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Performance results of one test together with task and environment info
+struct PerfRecord {
+  std::string task_id;
+  // mpi, omp, seq, stl or tbb
+  std::string backend;
+  std::string type_of_running;
+  std::string cpu_model;
+  uint64_t cores_count = 0;
+  // unix time of the measurement
+  int64_t timestamp = 0;
+  PerfResults results;
+};
+
+// Writer of performance results as JSON Lines or CSV records
+class PerfWriter {
+ public:
+  enum class Format { JSON_LINES, CSV };
+
+  PerfWriter(std::ostream &out_, Format format_);
+
+  // write header line (CSV only)
+  void write_header();
+
+  // write one record as a line
+  void write(const PerfRecord &record);
+
+  // record of results of test which is defined in test_file_path
+  static PerfRecord make_record(const std::string &test_file_path, const PerfResults &results);
+
+  // "tasks/<backend>/<task_id>" part of path of perf test of task, empty if
+  // path is not a perf test of task
+  static std::string task_path(const std::string &test_file_path);
+
+  static std::string type_of_running_name(PerfResults::TypeOfRunning type_of_running);
+
+  // CPU model name, "unknown" if it can't be detected
+  static std::string cpu_model();
+
+ private:
+  struct Field {
+    std::string name;
+    std::string value;
+    bool is_string;
+  };
+  static std::vector<Field> fields(const PerfRecord &record);
+
+  std::ostream &out;
+  Format format;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_WRITER_HPP_
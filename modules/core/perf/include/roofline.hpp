@@ -0,0 +1,38 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ROOFLINE_HPP_
+#define MODULES_CORE_INCLUDE_ROOFLINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::core {
+
+struct MachinePeak {
+  // memory bandwidth of STREAM triad (GB/s)
+  double bandwidth_gbs = 0.0;
+  // double precision multiply-add throughput (GFLOP/s)
+  double gflops = 0.0;
+};
+
+// Micro-benchmarks of peaks of the machine for roofline analysis
+class Roofline {
+ public:
+  // peaks for count of threads, measured once per process and count
+  static MachinePeak peak(size_t num_threads);
+
+  // bandwidth of triad a[i] = b[i] + s * c[i] over arrays of bytes in total
+  static double measure_bandwidth(size_t num_threads, size_t bytes);
+
+  // throughput of independent multiply-add chains
+  static double measure_gflops(size_t num_threads);
+
+  // part of attainable performance min(peak GFLOP/s, intensity * peak GB/s)
+  // reached by the task; without ops it is part of peak bandwidth, without
+  // bytes it is part of peak GFLOP/s
+  static double efficiency(const MachinePeak& machine_peak, uint64_t bytes, uint64_t ops, double time_sec);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ROOFLINE_HPP_
@@ -0,0 +1,32 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STATS_HPP_
+#define MODULES_CORE_INCLUDE_STATS_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core::stats {
+
+// arithmetic mean of samples
+double mean(const std::vector<double>& samples);
+
+// sample standard deviation (with Bessel's correction)
+double stddev(const std::vector<double>& samples);
+
+// q-quantile (0 <= q <= 1) of sorted samples with linear interpolation
+double quantile(const std::vector<double>& sorted, double q);
+
+// two-sided 95% critical value of Student's t-distribution
+double student_t95(size_t degrees_of_freedom);
+
+// sorted samples which lie inside Tukey's fences [Q1 - 1.5 IQR, Q3 + 1.5 IQR]
+std::vector<double> reject_outliers(const std::vector<double>& sorted);
+
+// two-sided p-value of Mann-Whitney U test that samples a and b come from the
+// same distribution (normal approximation with correction for ties)
+double mann_whitney_p(const std::vector<double>& a, const std::vector<double>& b);
+
+}  // namespace ppc::core::stats
+
+#endif  // MODULES_CORE_INCLUDE_STATS_HPP_
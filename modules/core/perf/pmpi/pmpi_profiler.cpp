@@ -0,0 +1,283 @@
+// Copyright 2024 Nesterov Alexander
+
+// PMPI profiling layer: MPI calls of the executable (including the ones made
+// by boost::mpi) are intercepted here and forwarded to PMPI_* functions. Count
+// of calls, volume of data sent or received by the process and time of each
+// call are accounted in ppc::core::CommStats for the phase of task being
+// executed. Non-blocking receives count their bytes when they complete, time of
+// completion and probe calls is accounted as CommOp::WAIT. This file is linked
+// into MPI perf tests only.
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/perf/include/comm_stats.hpp"
+
+namespace {
+
+using ppc::core::CommOp;
+using ppc::core::CommStats;
+
+uint64_t bytes_of(int count, MPI_Datatype datatype) {
+  int type_size = 0;
+  PMPI_Type_size(datatype, &type_size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(type_size);
+}
+
+uint64_t bytes_of(const int* counts, int comm_size, MPI_Datatype datatype) {
+  uint64_t bytes = 0;
+  for (int i = 0; i < comm_size; i++) {
+    bytes += bytes_of(counts[i], datatype);
+  }
+  return bytes;
+}
+
+int comm_size_of(MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool is_root(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+template <typename Call>
+int profile(CommOp op, uint64_t bytes, Call call) {
+  auto begin = PMPI_Wtime();
+  int result = call();
+  CommStats::record(op, bytes, PMPI_Wtime() - begin);
+  return result;
+}
+
+// datatypes of receives posted by MPI_Irecv till their completion
+std::mutex pending_mutex;
+std::unordered_map<MPI_Request, MPI_Datatype> pending_recvs;
+
+// account bytes of a completed request if it's a pending receive
+void complete(MPI_Request request, MPI_Status* status) {
+  MPI_Datatype datatype = MPI_DATATYPE_NULL;
+  {
+    std::lock_guard lock(pending_mutex);
+    auto it = pending_recvs.find(request);
+    if (it == pending_recvs.end()) return;
+    datatype = it->second;
+    pending_recvs.erase(it);
+  }
+  int count = 0;
+  PMPI_Get_count(status, datatype, &count);
+  if (count != MPI_UNDEFINED) CommStats::record(CommOp::RECV, bytes_of(count, datatype), 0.0, 0);
+}
+
+// call of a completion function for requests; completed(statuses, i) tells if
+// the i-th request is completed by the call
+template <typename Call, typename IsCompleted>
+int profile_completion(int count, const MPI_Request* requests, MPI_Status* statuses, Call call,
+                       IsCompleted completed) {
+  std::vector<MPI_Request> posted(requests, requests + count);
+  std::vector<MPI_Status> local_statuses(statuses == MPI_STATUSES_IGNORE ? count : 0);
+  if (statuses == MPI_STATUSES_IGNORE) statuses = local_statuses.data();
+  auto begin = PMPI_Wtime();
+  int result = call(statuses);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  for (int i = 0; i < count; i++) {
+    if (posted[i] != MPI_REQUEST_NULL && completed(statuses, i)) complete(posted[i], &statuses[i]);
+  }
+  return result;
+}
+
+}  // namespace
+
+extern "C" {
+
+int MPI_Send(const void* buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return profile(CommOp::SEND, bytes_of(count, datatype),
+                 [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Ssend(const void* buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return profile(CommOp::SEND, bytes_of(count, datatype),
+                 [&] { return PMPI_Ssend(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Isend(const void* buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request* request) {
+  return profile(CommOp::SEND, bytes_of(count, datatype),
+                 [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Recv(void* buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status* status) {
+  MPI_Status local_status;
+  if (status == MPI_STATUS_IGNORE) status = &local_status;
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Recv(buf, count, datatype, source, tag, comm, status);
+  auto time = PMPI_Wtime() - begin;
+  int received_count = 0;
+  PMPI_Get_count(status, datatype, &received_count);
+  CommStats::record(CommOp::RECV, bytes_of(received_count == MPI_UNDEFINED ? count : received_count, datatype), time);
+  return result;
+}
+
+int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request* request) {
+  // bytes are known when the receive completes
+  int result = profile(CommOp::RECV, 0, [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+  if (result == MPI_SUCCESS) {
+    std::lock_guard lock(pending_mutex);
+    pending_recvs[*request] = datatype;
+  }
+  return result;
+}
+
+int MPI_Wait(MPI_Request* request, MPI_Status* status) {
+  return profile_completion(
+      1, request, status == MPI_STATUS_IGNORE ? MPI_STATUSES_IGNORE : status,
+      [&](MPI_Status* statuses) { return PMPI_Wait(request, statuses); }, [](MPI_Status*, int) { return true; });
+}
+
+int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[]) {
+  return profile_completion(
+      count, requests, statuses, [&](MPI_Status* all_statuses) { return PMPI_Waitall(count, requests, all_statuses); },
+      [](MPI_Status*, int) { return true; });
+}
+
+int MPI_Waitany(int count, MPI_Request requests[], int* index, MPI_Status* status) {
+  MPI_Status local_status;
+  if (status == MPI_STATUS_IGNORE) status = &local_status;
+  std::vector<MPI_Request> posted(requests, requests + count);
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Waitany(count, requests, index, status);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  if (*index != MPI_UNDEFINED) complete(posted[*index], status);
+  return result;
+}
+
+int MPI_Waitsome(int incount, MPI_Request requests[], int* outcount, int indices[], MPI_Status statuses[]) {
+  std::vector<MPI_Request> posted(requests, requests + incount);
+  std::vector<MPI_Status> local_statuses(statuses == MPI_STATUSES_IGNORE ? incount : 0);
+  if (statuses == MPI_STATUSES_IGNORE) statuses = local_statuses.data();
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Waitsome(incount, requests, outcount, indices, statuses);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  for (int i = 0; *outcount != MPI_UNDEFINED && i < *outcount; i++) complete(posted[indices[i]], &statuses[i]);
+  return result;
+}
+
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status) {
+  return profile_completion(
+      1, request, status == MPI_STATUS_IGNORE ? MPI_STATUSES_IGNORE : status,
+      [&](MPI_Status* statuses) { return PMPI_Test(request, flag, statuses); },
+      [&](MPI_Status*, int) { return *flag != 0; });
+}
+
+int MPI_Testall(int count, MPI_Request requests[], int* flag, MPI_Status statuses[]) {
+  return profile_completion(
+      count, requests, statuses,
+      [&](MPI_Status* all_statuses) { return PMPI_Testall(count, requests, flag, all_statuses); },
+      [&](MPI_Status*, int) { return *flag != 0; });
+}
+
+int MPI_Testany(int count, MPI_Request requests[], int* index, int* flag, MPI_Status* status) {
+  MPI_Status local_status;
+  if (status == MPI_STATUS_IGNORE) status = &local_status;
+  std::vector<MPI_Request> posted(requests, requests + count);
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Testany(count, requests, index, flag, status);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  if (*flag != 0 && *index != MPI_UNDEFINED) complete(posted[*index], status);
+  return result;
+}
+
+int MPI_Testsome(int incount, MPI_Request requests[], int* outcount, int indices[], MPI_Status statuses[]) {
+  std::vector<MPI_Request> posted(requests, requests + incount);
+  std::vector<MPI_Status> local_statuses(statuses == MPI_STATUSES_IGNORE ? incount : 0);
+  if (statuses == MPI_STATUSES_IGNORE) statuses = local_statuses.data();
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Testsome(incount, requests, outcount, indices, statuses);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  for (int i = 0; *outcount != MPI_UNDEFINED && i < *outcount; i++) complete(posted[indices[i]], &statuses[i]);
+  return result;
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status* status) {
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Probe(source, tag, comm, status);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  return result;
+}
+
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int* flag, MPI_Status* status) {
+  auto begin = PMPI_Wtime();
+  int result = PMPI_Iprobe(source, tag, comm, flag, status);
+  CommStats::record(CommOp::WAIT, 0, PMPI_Wtime() - begin, 0);
+  return result;
+}
+
+int MPI_Bcast(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  return profile(CommOp::BCAST, bytes_of(count, datatype),
+                 [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Scatter(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  auto bytes = is_root(root, comm) ? bytes_of(sendcount, sendtype) * comm_size_of(comm) : bytes_of(recvcount, recvtype);
+  return profile(CommOp::SCATTER, bytes, [&] {
+    return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Scatterv(const void* sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype, void* recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  auto bytes = is_root(root, comm) ? bytes_of(sendcounts, comm_size_of(comm), sendtype) : bytes_of(recvcount, recvtype);
+  return profile(CommOp::SCATTER, bytes, [&] {
+    return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  auto bytes = is_root(root, comm) ? bytes_of(recvcount, recvtype) * comm_size_of(comm) : bytes_of(sendcount, sendtype);
+  return profile(CommOp::GATHER, bytes, [&] {
+    return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  auto bytes = is_root(root, comm) ? bytes_of(recvcounts, comm_size_of(comm), recvtype) : bytes_of(sendcount, sendtype);
+  return profile(CommOp::GATHER, bytes, [&] {
+    return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+  });
+}
+
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  return profile(CommOp::GATHER, bytes_of(recvcount, recvtype) * comm_size_of(comm), [&] {
+    return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Allgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  return profile(CommOp::GATHER, bytes_of(recvcounts, comm_size_of(comm), recvtype), [&] {
+    return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  });
+}
+
+int MPI_Reduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  return profile(CommOp::REDUCE, bytes_of(count, datatype),
+                 [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return profile(CommOp::REDUCE, bytes_of(count, datatype),
+                 [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+}  // extern "C"
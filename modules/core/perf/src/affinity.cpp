@@ -0,0 +1,178 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/affinity.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+std::mutex policy_mutex;
+ppc::core::AffinityPolicy current_policy = ppc::core::AffinityPolicy::NONE;
+std::vector<int> current_placement;
+
+int read_topology_value(int cpu, const std::string& name) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+  int value = 0;
+  file >> value;
+  return value;
+}
+
+#ifdef __linux__
+std::vector<int> allowed_cpus() {
+  std::vector<int> cpus;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+bool set_thread_cpus(const std::vector<int>& cpus) {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+  }
+  return CPU_COUNT(&mask) != 0 && sched_setaffinity(0, sizeof(mask), &mask) == 0;
+}
+#else
+std::vector<int> allowed_cpus() { return {}; }
+
+bool set_thread_cpus(const std::vector<int>& /*cpus*/) { return false; }
+#endif
+
+// CPUs of the process before any thread is pinned, workers get them back when
+// the policy is NONE
+const std::vector<int> process_cpus = allowed_cpus();
+
+}  // namespace
+
+std::vector<ppc::core::CpuInfo> ppc::core::Affinity::topology() {
+  std::vector<CpuInfo> cpus;
+  // (package, core_id) -> count of hardware threads found so far
+  std::map<std::pair<int, int>, int> threads_of_core;
+  // package -> core_id -> index of core in package
+  std::map<int, std::map<int, int>> cores_of_package;
+  for (auto cpu : allowed_cpus()) {
+    auto package = read_topology_value(cpu, "physical_package_id");
+    auto core_id = read_topology_value(cpu, "core_id");
+    auto& cores = cores_of_package[package];
+    auto core = cores.emplace(core_id, static_cast<int>(cores.size())).first->second;
+    cpus.push_back(CpuInfo{cpu, package, core, threads_of_core[{package, core_id}]++});
+  }
+  return cpus;
+}
+
+std::vector<int> ppc::core::Affinity::placement(AffinityPolicy policy, const std::vector<int>& explicit_cpus) {
+  if (policy == AffinityPolicy::NONE) return {};
+  if (policy == AffinityPolicy::EXPLICIT) return explicit_cpus;
+
+  auto cpus = topology();
+  if (policy == AffinityPolicy::PHYSICAL_CORES) {
+    std::erase_if(cpus, [](const CpuInfo& info) { return info.smt != 0; });
+  }
+  std::sort(cpus.begin(), cpus.end(), [policy](const CpuInfo& a, const CpuInfo& b) {
+    if (policy == AffinityPolicy::SCATTER) {
+      return std::tie(a.smt, a.core, a.package) < std::tie(b.smt, b.core, b.package);
+    }
+    return std::tie(a.package, a.core, a.smt) < std::tie(b.package, b.core, b.smt);
+  });
+
+  std::vector<int> result;
+  result.reserve(cpus.size());
+  for (const auto& info : cpus) {
+    result.push_back(info.cpu);
+  }
+  return result;
+}
+
+void ppc::core::Affinity::set_policy(AffinityPolicy policy, const std::vector<int>& explicit_cpus) {
+  auto cpus = placement(policy, explicit_cpus);
+  std::lock_guard lock(policy_mutex);
+  current_policy = policy;
+  current_placement = std::move(cpus);
+}
+
+ppc::core::AffinityPolicy ppc::core::Affinity::get_policy() {
+  std::lock_guard lock(policy_mutex);
+  return current_policy;
+}
+
+bool ppc::core::Affinity::pin_worker(size_t worker_index) {
+  int cpu = 0;
+  {
+    std::lock_guard lock(policy_mutex);
+    if (current_policy == AffinityPolicy::NONE) {
+      set_thread_cpus(process_cpus);
+      return false;
+    }
+    if (current_placement.empty()) return false;
+    cpu = current_placement[worker_index % current_placement.size()];
+  }
+  return pin_thread(cpu);
+}
+
+bool ppc::core::Affinity::pin_thread(int cpu) { return set_thread_cpus({cpu}); }
+
+size_t ppc::core::Affinity::local_rank() {
+  for (const char* name : {"OMPI_COMM_WORLD_LOCAL_RANK", "MPI_LOCALRANKID", "MPI_LOCAL_RANK", "SLURM_LOCALID"}) {
+    const char* value = std::getenv(name);
+    if (value != nullptr) return std::strtoull(value, nullptr, 10);
+  }
+  return 0;
+}
+
+const char* ppc::core::Affinity::policy_name(AffinityPolicy policy) {
+  switch (policy) {
+    case AffinityPolicy::NONE:
+      return "none";
+    case AffinityPolicy::COMPACT:
+      return "compact";
+    case AffinityPolicy::SCATTER:
+      return "scatter";
+    case AffinityPolicy::PHYSICAL_CORES:
+      return "physical_cores";
+    case AffinityPolicy::EXPLICIT:
+      return "explicit";
+  }
+  return "unknown";
+}
+
+ppc::core::ScopedAffinity::ScopedAffinity(AffinityPolicy policy, const std::vector<int>& explicit_cpus,
+                                          std::function<void()> pin_workers_)
+    : is_active(policy != AffinityPolicy::NONE), pin_workers(std::move(pin_workers_)) {
+  if (!is_active) return;
+  {
+    std::lock_guard lock(policy_mutex);
+    previous_policy = current_policy;
+    previous_placement = current_placement;
+  }
+  thread_cpus = allowed_cpus();
+  Affinity::set_policy(policy, explicit_cpus);
+  Affinity::pin_worker(Affinity::local_rank());
+  if (pin_workers) pin_workers();
+}
+
+ppc::core::ScopedAffinity::~ScopedAffinity() {
+  if (!is_active) return;
+  set_thread_cpus(thread_cpus);
+  {
+    std::lock_guard lock(policy_mutex);
+    current_policy = previous_policy;
+    current_placement = std::move(previous_placement);
+  }
+  // workers are pinned by the previous policy or get all CPUs back
+  if (pin_workers) pin_workers();
+}
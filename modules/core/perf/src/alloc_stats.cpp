@@ -0,0 +1,83 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/alloc_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+// Counters are updated from any thread and must not allocate
+struct AtomicPhaseStats {
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> deallocations{0};
+  std::atomic<uint64_t> allocated_bytes{0};
+  std::atomic<uint64_t> peak_live_bytes{0};
+};
+
+std::array<AtomicPhaseStats, ppc::core::AllocStats::phases_count> counters;
+std::atomic<int64_t> live_bytes{0};
+std::atomic<bool> is_enabled{false};
+
+AtomicPhaseStats& active_counters() { return counters[static_cast<size_t>(ppc::core::Task::get_active_phase())]; }
+
+}  // namespace
+
+ppc::core::AllocPhaseStats ppc::core::AllocStats::total() const {
+  AllocPhaseStats result;
+  for (const auto& phase : phases) {
+    result.allocations += phase.allocations;
+    result.deallocations += phase.deallocations;
+    result.allocated_bytes += phase.allocated_bytes;
+    result.peak_live_bytes = std::max(result.peak_live_bytes, phase.peak_live_bytes);
+  }
+  return result;
+}
+
+ppc::core::AllocStats ppc::core::AllocStats::since(const AllocStats& snapshot) const {
+  AllocStats result;
+  for (size_t i = 0; i < phases_count; i++) {
+    result.phases[i].allocations = phases[i].allocations - snapshot.phases[i].allocations;
+    result.phases[i].deallocations = phases[i].deallocations - snapshot.phases[i].deallocations;
+    result.phases[i].allocated_bytes = phases[i].allocated_bytes - snapshot.phases[i].allocated_bytes;
+    result.phases[i].peak_live_bytes = phases[i].peak_live_bytes;
+  }
+  return result;
+}
+
+ppc::core::AllocStats ppc::core::AllocStats::snapshot() {
+  AllocStats result;
+  for (size_t i = 0; i < phases_count; i++) {
+    result.phases[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+    result.phases[i].deallocations = counters[i].deallocations.load(std::memory_order_relaxed);
+    result.phases[i].allocated_bytes = counters[i].allocated_bytes.load(std::memory_order_relaxed);
+    result.phases[i].peak_live_bytes = counters[i].peak_live_bytes.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+bool ppc::core::AllocStats::enabled() { return is_enabled.load(std::memory_order_relaxed); }
+
+void ppc::core::AllocStats::reset_peaks() {
+  auto live = static_cast<uint64_t>(std::max<int64_t>(0, live_bytes.load(std::memory_order_relaxed)));
+  for (auto& phase : counters) {
+    phase.peak_live_bytes.store(live, std::memory_order_relaxed);
+  }
+}
+
+void ppc::core::AllocStats::record_allocation(size_t size) {
+  auto& phase = active_counters();
+  phase.allocations.fetch_add(1, std::memory_order_relaxed);
+  phase.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  auto live = live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+  auto peak = phase.peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > static_cast<int64_t>(peak) &&
+         !phase.peak_live_bytes.compare_exchange_weak(peak, static_cast<uint64_t>(live), std::memory_order_relaxed)) {
+  }
+}
+
+void ppc::core::AllocStats::record_deallocation(size_t size) {
+  active_counters().deallocations.fetch_add(1, std::memory_order_relaxed);
+  live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+void ppc::core::AllocStats::mark_enabled() { is_enabled.store(true, std::memory_order_relaxed); }
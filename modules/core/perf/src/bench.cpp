@@ -0,0 +1,110 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "core/perf/include/cache_flusher.hpp"
+
+ppc::core::BenchData::BenchData() : taskData(std::make_shared<TaskData>()) {}
+
+bool ppc::core::Bench::add(const std::string& name, size_t element_size, CaseFactory factory) {
+  registry().push_back(Entry{name, element_size, std::move(factory)});
+  return true;
+}
+
+std::vector<ppc::core::Bench::Entry>& ppc::core::Bench::registry() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+std::vector<uint64_t> ppc::core::Bench::sizes(size_t element_size) {
+  // 16 KiB and 256 KiB fit L1 and L2 of current cores; DRAM-resident input is
+  // four times the last level cache
+  constexpr size_t l1_bytes = 16 * 1024;
+  constexpr size_t l2_bytes = 256 * 1024;
+  constexpr size_t default_cache_bytes = 32 * 1024 * 1024;
+  constexpr size_t max_dram_bytes = 512 * 1024 * 1024;
+  auto cache_bytes = CacheFlusher::largest_cache_size();
+  if (cache_bytes == 0) cache_bytes = default_cache_bytes;
+  auto cache_resident_bytes = std::max(cache_bytes / 2, 2 * l2_bytes);
+  auto dram_bytes = std::min(std::max(4 * cache_bytes, 2 * cache_resident_bytes), max_dram_bytes);
+
+  std::vector<uint64_t> result;
+  for (auto bytes : {l1_bytes, l2_bytes, cache_resident_bytes, dram_bytes}) {
+    result.push_back(bytes / element_size);
+  }
+  return result;
+}
+
+std::vector<ppc::core::BenchResult> ppc::core::Bench::run(const BenchOptions& options, std::ostream& out) {
+  std::regex filter(options.filter);
+  std::vector<BenchResult> bench_results;
+  for (const auto& entry : registry()) {
+    for (auto size : sizes(entry.element_size)) {
+      auto full_name = entry.name + "/" + std::to_string(size);
+      if (!std::regex_search(full_name, filter)) continue;
+
+      BenchData data;
+      auto task = entry.factory(data, size);
+
+      auto perfAttr = std::make_shared<PerfAttr>();
+      perfAttr->num_running = 1;
+      perfAttr->num_warmup = 1;
+      perfAttr->target_time_sec = options.min_time_sec;
+      perfAttr->num_elements = size;
+      perfAttr->num_workers = 1;
+      const auto t0 = std::chrono::steady_clock::now();
+      perfAttr->current_timer = [&] {
+        auto current_time_point = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+        return static_cast<double>(duration) * 1e-9;
+      };
+
+      BenchResult bench_result{entry.name, size, std::make_shared<PerfResults>()};
+      Perf perf(task);
+      perf.task_run(perfAttr, bench_result.results);
+      if (bench_result.results->median_sec > 0.0) {
+        bench_result.elements_per_sec = static_cast<double>(size) / bench_result.results->median_sec;
+      }
+
+      out << "bench:" << full_name << ":" << std::fixed << std::setprecision(10) << bench_result.results->median_sec
+          << ":" << std::scientific << std::setprecision(4) << bench_result.elements_per_sec << ":" << std::fixed
+          << std::setprecision(3) << bench_result.results->bandwidth_gbs << std::endl;
+      bench_results.push_back(std::move(bench_result));
+    }
+  }
+  return bench_results;
+}
+
+int ppc::core::Bench::main(int argc, char** argv) {
+  BenchOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string_view arg(argv[i]);
+    constexpr std::string_view filter_flag = "--benchmark_filter=";
+    constexpr std::string_view min_time_flag = "--benchmark_min_time=";
+    try {
+      if (arg.starts_with(filter_flag)) {
+        options.filter = arg.substr(filter_flag.size());
+        std::regex check(options.filter);
+      } else if (arg.starts_with(min_time_flag)) {
+        options.min_time_sec = std::stod(std::string(arg.substr(min_time_flag.size())));
+      } else {
+        throw std::invalid_argument("unknown argument");
+      }
+    } catch (const std::exception& error) {
+      std::cerr << "Invalid argument " << arg << ": " << error.what() << std::endl;
+      std::cerr << "Usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]"
+                << std::endl;
+      return 1;
+    }
+  }
+  run(options, std::cout);
+  return 0;
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/cache_flusher.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+ppc::core::CacheFlusher::CacheFlusher(size_t size_) {
+  if (size_ == 0) {
+    auto cache_size = largest_cache_size();
+    size_ = cache_size != 0 ? std::min(2 * cache_size, max_size) : default_size;
+  }
+  buffer.resize(size_);
+}
+
+void ppc::core::CacheFlusher::flush() {
+  // Writes make lines of the buffer dirty, so lines of the task are evicted
+  // from every level of caches. Buffer outlives the call, so writes can't be
+  // optimized out.
+  for (size_t i = 0; i < buffer.size(); i += cache_line_size) {
+    buffer[i]++;
+  }
+}
+
+size_t ppc::core::CacheFlusher::largest_cache_size() {
+  size_t result = 0;
+  for (int index = 0;; index++) {
+    std::ifstream size_file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+    std::string size_str;
+    if (!(size_file >> size_str)) break;
+    size_t pos = 0;
+    size_t size = std::stoull(size_str, &pos);
+    if (pos < size_str.size()) {
+      if (size_str[pos] == 'K') size *= 1024;
+      if (size_str[pos] == 'M') size *= 1024 * 1024;
+    }
+    result = std::max(result, size);
+  }
+  return result;
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/comm_stats.hpp"
+
+namespace {
+
+void add(ppc::core::CommOpStats& to, const ppc::core::CommOpStats& from) {
+  to.messages += from.messages;
+  to.bytes += from.bytes;
+  to.time_sec += from.time_sec;
+}
+
+}  // namespace
+
+ppc::core::CommOpStats ppc::core::CommStats::phase_total(Task::Phase phase) const {
+  CommOpStats result;
+  for (const auto& op_stats : ops[static_cast<size_t>(phase)]) {
+    add(result, op_stats);
+  }
+  return result;
+}
+
+ppc::core::CommOpStats ppc::core::CommStats::total() const {
+  CommOpStats result;
+  for (size_t i = 0; i < phases_count; i++) {
+    add(result, phase_total(static_cast<Task::Phase>(i)));
+  }
+  return result;
+}
+
+ppc::core::CommStats ppc::core::CommStats::since(const CommStats& snapshot) const {
+  CommStats result;
+  for (size_t i = 0; i < phases_count; i++) {
+    for (size_t j = 0; j < ops_count; j++) {
+      auto& op_stats = result.ops[i][j];
+      op_stats.messages = ops[i][j].messages - snapshot.ops[i][j].messages;
+      op_stats.bytes = ops[i][j].bytes - snapshot.ops[i][j].bytes;
+      op_stats.time_sec = ops[i][j].time_sec - snapshot.ops[i][j].time_sec;
+    }
+  }
+  return result;
+}
+
+ppc::core::CommStats& ppc::core::CommStats::global() {
+  static CommStats stats;
+  return stats;
+}
+
+void ppc::core::CommStats::record(CommOp op, uint64_t bytes, double time_sec, uint64_t messages) {
+  auto& op_stats = global().at(Task::get_active_phase(), op);
+  op_stats.messages += messages;
+  op_stats.bytes += bytes;
+  op_stats.time_sec += time_sec;
+}
+
+const char* ppc::core::CommStats::op_name(CommOp op) {
+  switch (op) {
+    case CommOp::SEND:
+      return "send";
+    case CommOp::RECV:
+      return "recv";
+    case CommOp::BCAST:
+      return "bcast";
+    case CommOp::SCATTER:
+      return "scatter";
+    case CommOp::GATHER:
+      return "gather";
+    case CommOp::REDUCE:
+      return "reduce";
+    case CommOp::WAIT:
+      return "wait";
+  }
+  return "unknown";
+}
@@ -0,0 +1,108 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/hw_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+#include <utility>
+
+namespace {
+
+#ifdef __linux__
+// Counters are opened as one group led by group_fd (-1 for the leader), so the
+// kernel schedules them together and they count over the same time even when
+// they are multiplexed with other events
+int open_counter(uint32_t type, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.inherit = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // Kernel and hypervisor are excluded to work with perf_event_paranoid = 2
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+}  // namespace
+
+ppc::core::HwCounters::HwCounters() {
+  fds.fill(-1);
+#ifdef __linux__
+  const std::array<std::pair<uint32_t, uint64_t>, counters_count> events = {{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {PERF_TYPE_HW_CACHE,
+       PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  }};
+  // the first counter which can be opened leads the group
+  for (size_t i = 0; i < counters_count; i++) {
+    fds[i] = open_counter(events[i].first, events[i].second, leader_fd);
+    if (leader_fd < 0) leader_fd = fds[i];
+  }
+#endif
+}
+
+ppc::core::HwCounters::~HwCounters() {
+#ifdef __linux__
+  for (auto fd : fds) {
+    if (fd >= 0) close(fd);
+  }
+#endif
+}
+
+bool ppc::core::HwCounters::available() const {
+  for (auto fd : fds) {
+    if (fd >= 0) return true;
+  }
+  return false;
+}
+
+void ppc::core::HwCounters::start() {
+#ifdef __linux__
+  if (leader_fd < 0) return;
+  ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void ppc::core::HwCounters::pause() {
+#ifdef __linux__
+  if (leader_fd >= 0) ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void ppc::core::HwCounters::resume() {
+#ifdef __linux__
+  if (leader_fd >= 0) ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+ppc::core::HwCountersValues ppc::core::HwCounters::stop() {
+  std::array<std::optional<uint64_t>, counters_count> values;
+#ifdef __linux__
+  pause();
+  for (size_t i = 0; i < counters_count; i++) {
+    if (fds[i] < 0) continue;
+    // value, time enabled and time running
+    std::array<uint64_t, 3> data{};
+    if (read(fds[i], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) continue;
+    // scale to the whole enabled time if the group was multiplexed
+    auto scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+  }
+#endif
+  return {values[0], values[1], values[2], values[3], values[4]};
+}
@@ -3,11 +3,24 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <utility>
 
+#include "core/perf/include/cache_flusher.hpp"
+#include "core/perf/include/perf_baseline.hpp"
+#include "core/perf/include/perf_writer.hpp"
+#include "core/perf/include/roofline.hpp"
+#include "core/perf/include/stats.hpp"
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -19,15 +32,22 @@ void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
 
+  Task::TimePoint pipeline_end;
   common_run(
-      std::move(perfAttr),
+      perfAttr,
       [&]() {
         task->validation();
         task->pre_processing();
         task->run();
         task->post_processing();
+        pipeline_end = std::chrono::high_resolution_clock::now();
       },
-      std::move(perfResults));
+      perfResults, [&]() {
+        // phases are accumulated after the measured time, samples contain only the task
+        task->end_trace_phase();
+        add_phases_time(perfResults, pipeline_end);
+      });
+  calc_task_metrics(perfAttr, perfResults);
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
@@ -36,46 +56,241 @@ void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
 
   task->validation();
   task->pre_processing();
-  common_run(std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
+  common_run(perfAttr, [&]() { task->run(); }, perfResults);
+  perfResults->phases_time_sec[static_cast<size_t>(Task::Phase::RUN)] = perfResults->time_sec;
   task->post_processing();
+  calc_task_metrics(perfAttr, perfResults);
 
   task->validation();
   task->pre_processing();
   task->run();
   task->post_processing();
+  task->end_trace_phase();
 }
 
 void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
-                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
-  auto begin = perfAttr->current_timer();
-  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                 const std::function<void()>& after_pipeline) {
+  ScopedAffinity affinity(perfAttr->affinity, perfAttr->affinity_cpus, perfAttr->pin_workers);
+  perfResults->affinity = perfAttr->affinity;
+
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
     pipeline();
+    if (after_pipeline) after_pipeline();
+  }
+
+  // Time of one run, in cold mode caches are flushed before it
+  std::unique_ptr<CacheFlusher> cache_flusher;
+  if (perfAttr->cache_mode == CacheMode::COLD) {
+    cache_flusher = std::make_unique<CacheFlusher>(perfAttr->cache_flush_bytes);
   }
-  auto end = perfAttr->current_timer();
-  perfResults->time_sec = end - begin;
+  perfResults->cache_mode = perfAttr->cache_mode;
+  // counters are started after calibration and don't count flushing
+  std::unique_ptr<HwCounters> hw_counters;
+  std::function<double()> measure = [&] {
+    if (cache_flusher) {
+      if (hw_counters) hw_counters->pause();
+      cache_flusher->flush();
+      if (hw_counters) hw_counters->resume();
+    }
+    auto begin = perfAttr->current_timer();
+    pipeline();
+    auto time = perfAttr->current_timer() - begin;
+    if (after_pipeline) after_pipeline();
+    return time;
+  };
+  auto num_running = calibrate_running(perfAttr, measure);
+
+  perfResults->phases_time_sec.fill(0.0);
+
+  if (perfAttr->collect_hw_counters) {
+    hw_counters = std::make_unique<HwCounters>();
+    hw_counters->start();
+  }
+
+  perfResults->samples_sec.clear();
+  perfResults->samples_sec.reserve(num_running);
+  auto comm_snapshot = CommStats::global();
+  auto alloc_snapshot = AllocStats::snapshot();
+  AllocStats::reset_peaks();
+  for (uint64_t i = 0; i < num_running; i++) {
+    perfResults->samples_sec.push_back(measure());
+  }
+  add_precision_runs(perfAttr, measure, perfResults);
+  perfResults->num_running = perfResults->samples_sec.size();
+
+  perfResults->hw_counters = hw_counters ? hw_counters->stop() : HwCountersValues{};
+  perfResults->comm_stats = CommStats::global().since(comm_snapshot);
+  perfResults->alloc_stats = AllocStats::snapshot().since(alloc_snapshot);
+  perfResults->time_sec = std::accumulate(perfResults->samples_sec.begin(), perfResults->samples_sec.end(), 0.0);
+  perfResults->comm_time_fraction =
+      perfResults->time_sec > 0.0 ? perfResults->comm_stats.total().time_sec / perfResults->time_sec : 0.0;
+  calc_statistics(perfAttr, perfResults);
 }
 
-void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
-  std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
-  std::string ppc_regex_template("parallel_programming_course");
-  std::string perf_regex_template("perf_tests");
-  std::string type_test_name;
+uint64_t ppc::core::Perf::calibrate_running(const std::shared_ptr<PerfAttr>& perfAttr,
+                                            const std::function<double()>& measure) {
+  auto target_time = perfAttr->target_time_sec;
+  if (target_time <= 0.0) return perfAttr->num_running;
 
-  auto time_secs = perfResults->time_sec;
+  // Double count of runs till they take a tenth of target time, then
+  // extrapolate time of one run to the target
+  uint64_t batch = 1;
+  while (true) {
+    double elapsed = 0.0;
+    for (uint64_t i = 0; i < batch; i++) {
+      elapsed += measure();
+    }
+    bool is_enough = elapsed >= 0.1 * target_time || batch >= perfAttr->max_running;
+    auto next_batch = perfAttr->reduce_count(is_enough ? 0 : 2 * batch);
+    if (next_batch == 0) {
+      auto estimate = perfAttr->max_running;
+      if (elapsed > 0.0) {
+        estimate = static_cast<uint64_t>(std::ceil(target_time * static_cast<double>(batch) / elapsed));
+      }
+      return std::clamp(perfAttr->reduce_count(estimate), perfAttr->min_running, perfAttr->max_running);
+    }
+    batch = next_batch;
+  }
+}
+
+void ppc::core::Perf::add_precision_runs(const std::shared_ptr<PerfAttr>& perfAttr,
+                                         const std::function<double()>& measure,
+                                         const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  if (perfAttr->target_precision <= 0.0) return;
+  auto& samples = perfResults->samples_sec;
+  // Half-width of confidence interval decreases as 1 / sqrt(count of runs),
+  // a few steps correct the estimate of the required count
+  constexpr int max_steps = 3;
+  for (int step = 0; step < max_steps; step++) {
+    uint64_t needed = samples.size();
+    if (samples.size() >= 2) {
+      auto mean = stats::mean(samples);
+      auto half_width = stats::student_t95(samples.size() - 1) * stats::stddev(samples) /
+                        std::sqrt(static_cast<double>(samples.size()));
+      auto precision = mean > 0.0 ? half_width / mean : 0.0;
+      if (precision > perfAttr->target_precision) {
+        auto ratio = precision / perfAttr->target_precision;
+        needed = static_cast<uint64_t>(std::ceil(static_cast<double>(samples.size()) * ratio * ratio));
+        // keep measured time in the limit of PerfResults::MAX_TIME
+        auto time_left = PerfResults::MAX_TIME / 2 - std::accumulate(samples.begin(), samples.end(), 0.0);
+        auto affordable = mean > 0.0 ? samples.size() + static_cast<uint64_t>(std::max(0.0, time_left / mean)) : 0;
+        needed = std::min({needed, affordable, perfAttr->max_running});
+      }
+    }
+    auto extra = perfAttr->reduce_count(needed > samples.size() ? needed - samples.size() : 0);
+    if (extra == 0) return;
+    for (uint64_t i = 0; i < extra; i++) {
+      samples.push_back(measure());
+    }
+  }
+}
+
+void ppc::core::Perf::add_phases_time(const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                      Task::TimePoint pipeline_end) const {
+  std::array<Task::TimePoint, 5> time_points = {
+      task->get_phase_time_point(Task::Phase::VALIDATION), task->get_phase_time_point(Task::Phase::PRE_PROCESSING),
+      task->get_phase_time_point(Task::Phase::RUN), task->get_phase_time_point(Task::Phase::POST_PROCESSING),
+      pipeline_end};
+  for (size_t i = 0; i < perfResults->phases_time_sec.size(); i++) {
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(time_points[i + 1] - time_points[i]).count();
+    perfResults->phases_time_sec[i] += static_cast<double>(duration) * 1e-9;
+  }
+}
+
+uint64_t ppc::core::Perf::detect_num_workers() {
+  for (const char* name : {"OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "OMP_NUM_THREADS"}) {
+    const char* value = std::getenv(name);
+    if (value != nullptr && std::strtoull(value, nullptr, 10) > 0) {
+      return std::strtoull(value, nullptr, 10);
+    }
+  }
+  // threads of other backends are not visible here, their tests set PerfAttr::num_workers
+  return 1;
+}
+
+void ppc::core::Perf::calc_task_metrics(const std::shared_ptr<PerfAttr>& perfAttr,
+                                        const std::shared_ptr<ppc::core::PerfResults>& perfResults) const {
+  perfResults->num_elements = perfAttr->num_elements;
+  if (perfResults->num_elements == 0) {
+    const auto& inputs_count = task->get_data()->inputs_count;
+    perfResults->num_elements = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+  }
+  perfResults->num_workers = perfAttr->num_workers != 0 ? perfAttr->num_workers : detect_num_workers();
 
-  if (perfResults->type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
-    type_test_name = "task_run";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
-    type_test_name = "pipeline";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::NONE) {
-    type_test_name = "none";
+  calc_counters_metrics(perfResults);
+
+  perfResults->bytes_per_run = task->bytes_per_run();
+  perfResults->ops_per_run = task->ops_per_run();
+  // samples of pipeline contain all phases, so time of run phase is used there
+  auto run_time = perfResults->median_sec;
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    run_time = perfResults->num_running > 0 ? perfResults->phases_time_sec[static_cast<size_t>(Task::Phase::RUN)] /
+                                                  static_cast<double>(perfResults->num_running)
+                                            : 0.0;
+  }
+  if (run_time > 0.0) {
+    perfResults->bandwidth_gbs = static_cast<double>(perfResults->bytes_per_run) / run_time * 1e-9;
+    perfResults->gflops = static_cast<double>(perfResults->ops_per_run) / run_time * 1e-9;
   }
+  if (perfAttr->roofline && (perfResults->bytes_per_run != 0 || perfResults->ops_per_run != 0)) {
+    auto machine_peak = Roofline::peak(perfResults->num_workers);
+    perfResults->peak_bandwidth_gbs = machine_peak.bandwidth_gbs;
+    perfResults->peak_gflops = machine_peak.gflops;
+    perfResults->roofline_efficiency =
+        Roofline::efficiency(machine_peak, perfResults->bytes_per_run, perfResults->ops_per_run, run_time);
+  }
+}
+
+void ppc::core::Perf::calc_counters_metrics(const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  const auto& counters = perfResults->hw_counters;
+  perfResults->ipc = 0.0;
+  if (counters.cycles && counters.instructions && *counters.cycles > 0) {
+    perfResults->ipc = static_cast<double>(*counters.instructions) / static_cast<double>(*counters.cycles);
+  }
+  // count of runs is the measured one, calibration may change it
+  auto total_elements = static_cast<double>(perfResults->num_elements * perfResults->num_running);
+  auto per_element = [&](const std::optional<uint64_t>& counter) {
+    return counter && total_elements > 0 ? static_cast<double>(*counter) / total_elements : 0.0;
+  };
+  perfResults->llc_misses_per_element = per_element(counters.llc_misses);
+  perfResults->branch_misses_per_element = per_element(counters.branch_misses);
+  perfResults->dtlb_misses_per_element = per_element(counters.dtlb_misses);
+}
 
-  auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
-  relative_path.erase(0, first_found_position);
+void ppc::core::Perf::calc_statistics(const std::shared_ptr<PerfAttr>& perfAttr,
+                                      const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  auto sorted = perfResults->samples_sec;
+  std::sort(sorted.begin(), sorted.end());
+  if (perfAttr->reject_outliers) {
+    auto filtered = stats::reject_outliers(sorted);
+    perfResults->outliers_count = sorted.size() - filtered.size();
+    sorted = std::move(filtered);
+  } else {
+    perfResults->outliers_count = 0;
+  }
+  if (sorted.empty()) return;
+
+  perfResults->min_sec = sorted.front();
+  perfResults->max_sec = sorted.back();
+  perfResults->mean_sec = stats::mean(sorted);
+  perfResults->median_sec = stats::quantile(sorted, 0.5);
+  perfResults->p95_sec = stats::quantile(sorted, 0.95);
+  perfResults->p99_sec = stats::quantile(sorted, 0.99);
+  perfResults->stddev_sec = stats::stddev(sorted);
+  auto half_width = stats::student_t95(sorted.size() - 1) * perfResults->stddev_sec /
+                    std::sqrt(static_cast<double>(sorted.size()));
+  perfResults->ci_low_sec = perfResults->mean_sec - half_width;
+  perfResults->ci_high_sec = perfResults->mean_sec + half_width;
+}
+
+void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+  std::string test_file_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
+  auto relative_path = PerfWriter::task_path(test_file_path);
+  if (relative_path.empty()) relative_path = test_file_path;
+  auto type_test_name = PerfWriter::type_of_running_name(perfResults->type_of_running);
 
-  auto last_found_position = relative_path.find(perf_regex_template) - 1;
-  relative_path.erase(last_found_position, relative_path.length() - 1);
+  auto time_secs = perfResults->time_sec;
 
   std::stringstream perf_res_str;
   if (time_secs < PerfResults::MAX_TIME) {
@@ -89,4 +304,86 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+  if (AllocStats::enabled()) print_alloc_statistic(perfResults);
+  if (perfResults->peak_bandwidth_gbs > 0.0) print_roofline_statistic(perfResults);
+
+  // Structured results are appended to file from PPC_PERF_OUTPUT: CSV for
+  // *.csv, JSON Lines otherwise
+  const char* output_path = std::getenv("PPC_PERF_OUTPUT");
+  if (output_path != nullptr && *output_path != '\0') {
+    std::string path(output_path);
+    auto format = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0 ? PerfWriter::Format::CSV
+                                                                                     : PerfWriter::Format::JSON_LINES;
+    std::ofstream output(path, std::ios::app);
+    PerfWriter writer(output, format);
+    if (output.tellp() == 0) writer.write_header();
+    writer.write(PerfWriter::make_record(test_file_path, *perfResults));
+  }
+
+  // Samples are compared with the baseline stored in PPC_PERF_BASELINE; they
+  // become the baseline if there is none or PPC_PERF_BASELINE_UPDATE is set
+  const char* baseline_path = std::getenv("PPC_PERF_BASELINE");
+  if (baseline_path != nullptr && *baseline_path != '\0') {
+    PerfBaseline baseline(baseline_path);
+    auto key = PerfBaseline::key(PerfWriter::make_record(test_file_path, *perfResults));
+    const auto* baseline_samples = baseline.find(key);
+    auto comparison = baseline_samples != nullptr ? PerfBaseline::compare(*baseline_samples, perfResults->samples_sec)
+                                                  : BaselineComparison{};
+    // formatted apart, so flags of std::cout stay unchanged
+    std::ostringstream baseline_str;
+    baseline_str << "baseline:" << PerfBaseline::verdict_name(comparison.verdict) << ":" << std::showpos
+                 << std::fixed << std::setprecision(2) << comparison.change * 100.0 << "%:" << std::noshowpos
+                 << std::setprecision(6) << comparison.p_value;
+    std::cout << baseline_str.str() << std::endl;
+    if (baseline_samples == nullptr || std::getenv("PPC_PERF_BASELINE_UPDATE") != nullptr) {
+      baseline.update(key, perfResults->samples_sec);
+      baseline.save();
+    }
+  }
+}
+
+void ppc::core::Perf::print_roofline_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+  std::ostringstream roofline_str;
+  roofline_str << "roofline:" << std::fixed << std::setprecision(3) << perfResults->bandwidth_gbs << ":"
+               << perfResults->peak_bandwidth_gbs << ":" << perfResults->gflops << ":" << perfResults->peak_gflops
+               << ":" << std::setprecision(4) << perfResults->roofline_efficiency;
+  std::cout << roofline_str.str() << std::endl;
+}
+
+void ppc::core::Perf::print_alloc_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+  const std::array<std::string, AllocStats::phases_count> names = {"validation", "pre_processing", "run",
+                                                                   "post_processing", "none"};
+  const auto& alloc_stats = perfResults->alloc_stats;
+  auto print = [](const std::string& phase_name, const AllocPhaseStats& phase_stats) {
+    std::cout << "alloc:" << phase_name << ":" << phase_stats.allocations << ":" << phase_stats.allocated_bytes << ":"
+              << phase_stats.peak_live_bytes << std::endl;
+  };
+  for (size_t i = 0; i < AllocStats::phases_count; i++) {
+    if (alloc_stats.phases[i].allocations != 0) print(names[i], alloc_stats.phases[i]);
+  }
+  print("total", alloc_stats.total());
+}
+
+void ppc::core::Perf::print_comm_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+  const std::array<std::string, CommStats::phases_count> names = {"validation", "pre_processing", "run",
+                                                                  "post_processing", "none"};
+  const auto& comm_stats = perfResults->comm_stats;
+  auto print = [](const std::string& phase_name, const std::string& op_name, const CommOpStats& op_stats) {
+    std::ostringstream comm_str;
+    comm_str << "comm:" << phase_name << ":" << op_name << ":" << op_stats.messages << ":" << op_stats.bytes << ":"
+             << std::fixed << std::setprecision(10) << op_stats.time_sec;
+    std::cout << comm_str.str() << std::endl;
+  };
+  for (size_t i = 0; i < CommStats::phases_count; i++) {
+    for (size_t j = 0; j < CommStats::ops_count; j++) {
+      const auto& op_stats = comm_stats.ops[i][j];
+      if (op_stats.messages != 0 || op_stats.bytes != 0 || op_stats.time_sec > 0.0) {
+        print(names[i], CommStats::op_name(static_cast<CommOp>(j)), op_stats);
+      }
+    }
+  }
+  print("total", "all", comm_stats.total());
+  std::ostringstream fraction_str;
+  fraction_str << "comm:fraction:" << std::fixed << std::setprecision(4) << perfResults->comm_time_fraction;
+  std::cout << fraction_str.str() << std::endl;
 }
@@ -0,0 +1,117 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_baseline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+#include "core/perf/include/stats.hpp"
+
+namespace {
+
+// tabs and line breaks separate fields and entries of the file
+std::string field(std::string str) {
+  std::replace_if(str.begin(), str.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+  return str;
+}
+
+double median(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  return ppc::core::stats::quantile(samples, 0.5);
+}
+
+}  // namespace
+
+ppc::core::PerfBaseline::PerfBaseline(std::string path_) : path(std::move(path_)), entries(load(path)) {}
+
+ppc::core::PerfBaseline::Entries ppc::core::PerfBaseline::load(const std::string &path) {
+  Entries entries;
+  std::ifstream input(path);
+  std::string line;
+  while (std::getline(input, line)) {
+    auto pos = line.rfind('\t');
+    if (pos == std::string::npos) continue;
+    std::istringstream samples_str(line.substr(pos + 1));
+    std::vector<double> samples;
+    double sample = 0.0;
+    while (samples_str >> sample) {
+      samples.push_back(sample);
+    }
+    entries[line.substr(0, pos)] = std::move(samples);
+  }
+  return entries;
+}
+
+std::string ppc::core::PerfBaseline::key(const PerfRecord &record) {
+  return field(record.task_id) + '\t' + field(record.backend) + '\t' + field(record.type_of_running) + '\t' +
+         std::to_string(record.results.num_elements) + '\t' + field(record.cpu_model) + " x" +
+         std::to_string(record.cores_count);
+}
+
+const std::vector<double> *ppc::core::PerfBaseline::find(const std::string &key) const {
+  auto it = entries.find(key);
+  return it != entries.end() ? &it->second : nullptr;
+}
+
+void ppc::core::PerfBaseline::update(const std::string &key, const std::vector<double> &samples) {
+  entries[key] = samples;
+  updated_keys.insert(key);
+}
+
+void ppc::core::PerfBaseline::save() const {
+  // entries saved by other processes since loading are kept
+  auto current = load(path);
+  for (const auto &key : updated_keys) current[key] = entries.at(key);
+
+  auto temp_path = path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream output(temp_path);
+    output << std::setprecision(10);
+    for (const auto &[key, samples] : current) {
+      output << key << '\t';
+      for (size_t i = 0; i < samples.size(); i++) {
+        output << (i == 0 ? "" : " ") << samples[i];
+      }
+      output << std::endl;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  if (error) std::filesystem::remove(temp_path, error);
+}
+
+ppc::core::BaselineComparison ppc::core::PerfBaseline::compare(const std::vector<double> &baseline,
+                                                               const std::vector<double> &samples, double alpha,
+                                                               double min_change) {
+  BaselineComparison comparison;
+  if (baseline.empty() || samples.empty()) return comparison;
+  auto baseline_median = median(baseline);
+  comparison.change = baseline_median > 0.0 ? median(samples) / baseline_median - 1.0 : 0.0;
+  comparison.p_value = stats::mann_whitney_p(baseline, samples);
+  comparison.verdict = BaselineComparison::Verdict::UNCHANGED;
+  if (comparison.p_value < alpha && std::abs(comparison.change) > min_change) {
+    comparison.verdict = comparison.change > 0.0 ? BaselineComparison::Verdict::REGRESSION
+                                                 : BaselineComparison::Verdict::IMPROVEMENT;
+  }
+  return comparison;
+}
+
+const char *ppc::core::PerfBaseline::verdict_name(BaselineComparison::Verdict verdict) {
+  switch (verdict) {
+    case BaselineComparison::Verdict::NO_BASELINE:
+      return "no_baseline";
+    case BaselineComparison::Verdict::UNCHANGED:
+      return "unchanged";
+    case BaselineComparison::Verdict::REGRESSION:
+      return "regression";
+    case BaselineComparison::Verdict::IMPROVEMENT:
+      return "improvement";
+  }
+  return "unknown";
+}
@@ -0,0 +1,99 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_compare.hpp"
+
+#include <numeric>
+#include <utility>
+
+#include "core/perf/include/cache_flusher.hpp"
+
+ppc::core::PerfCompare::PerfCompare(std::shared_ptr<Task> seq_task_, std::shared_ptr<Task> par_task_)
+    : seq_task(std::move(seq_task_)), par_task(std::move(par_task_)) {
+  for (const auto& task : {seq_task, par_task}) {
+    if (task) task->get_data()->state_of_testing = TaskData::StateOfTesting::PERF;
+  }
+}
+
+void ppc::core::PerfCompare::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                          const std::shared_ptr<CompareResults>& results) {
+  results->seq->type_of_running = results->par->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+  common_run(
+      perfAttr,
+      [](Task& task) {
+        task.validation();
+        task.pre_processing();
+        task.run();
+        task.post_processing();
+      },
+      results);
+}
+
+void ppc::core::PerfCompare::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                      const std::shared_ptr<CompareResults>& results) {
+  results->seq->type_of_running = results->par->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
+  for (const auto& task : {seq_task, par_task}) {
+    if (!task) continue;
+    task->validation();
+    task->pre_processing();
+  }
+  common_run(perfAttr, [](Task& task) { task.run(); }, results);
+  for (const auto& task : {seq_task, par_task}) {
+    if (task) task->post_processing();
+  }
+}
+
+void ppc::core::PerfCompare::common_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                        const std::function<void(Task&)>& pipeline,
+                                        const std::shared_ptr<CompareResults>& results) {
+  ScopedAffinity affinity(perfAttr->affinity, perfAttr->affinity_cpus, perfAttr->pin_workers);
+
+  auto& seq_samples = results->seq->samples_sec;
+  auto& par_samples = results->par->samples_sec;
+  seq_samples.clear();
+  par_samples.clear();
+
+  std::unique_ptr<CacheFlusher> cache_flusher;
+  if (perfAttr->cache_mode == CacheMode::COLD) {
+    cache_flusher = std::make_unique<CacheFlusher>(perfAttr->cache_flush_bytes);
+  }
+  auto measure = [&](const std::shared_ptr<Task>& task, std::vector<double>* samples) {
+    if (!task) return;
+    if (cache_flusher) cache_flusher->flush();
+    auto begin = perfAttr->current_timer();
+    pipeline(*task);
+    auto end = perfAttr->current_timer();
+    if (samples != nullptr) samples->push_back(end - begin);
+  };
+
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
+    measure(seq_task, nullptr);
+    measure(par_task, nullptr);
+  }
+  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+    if (i % 2 == 0) {
+      measure(seq_task, &seq_samples);
+      measure(par_task, &par_samples);
+    } else {
+      measure(par_task, &par_samples);
+      measure(seq_task, &seq_samples);
+    }
+  }
+
+  for (const auto& perfResults : {results->seq, results->par}) {
+    perfResults->num_running = perfResults->samples_sec.size();
+    perfResults->cache_mode = perfAttr->cache_mode;
+    perfResults->affinity = perfAttr->affinity;
+    perfResults->time_sec = std::accumulate(perfResults->samples_sec.begin(), perfResults->samples_sec.end(), 0.0);
+    Perf::calc_statistics(perfAttr, perfResults);
+  }
+
+  results->num_workers = perfAttr->num_workers != 0 ? perfAttr->num_workers : Perf::detect_num_workers();
+  results->speedup = results->efficiency = results->serial_fraction = 0.0;
+  if (seq_samples.empty() || results->par->median_sec <= 0.0) return;
+
+  auto p = static_cast<double>(results->num_workers);
+  results->speedup = results->seq->median_sec / results->par->median_sec;
+  results->efficiency = results->speedup / p;
+  if (results->num_workers > 1) {
+    results->serial_fraction = (1.0 / results->speedup - 1.0 / p) / (1.0 - 1.0 / p);
+  }
+}
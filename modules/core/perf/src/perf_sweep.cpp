@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_sweep.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+ppc::core::PerfSweep::PerfSweep(TaskFactory factory_) : factory(std::move(factory_)) {}
+
+void ppc::core::PerfSweep::run(const std::shared_ptr<PerfAttr>& perfAttr, const SweepAttr& sweepAttr,
+                               SweepResults& sweepResults) {
+  sweepResults.strong.clear();
+  sweepResults.weak.clear();
+  if (sweepAttr.strong_size != 0) sweepResults.strong = run_curve(perfAttr, sweepAttr, false);
+  if (sweepAttr.weak_size_per_worker != 0) sweepResults.weak = run_curve(perfAttr, sweepAttr, true);
+}
+
+std::vector<ppc::core::SweepPoint> ppc::core::PerfSweep::run_curve(const std::shared_ptr<PerfAttr>& perfAttr,
+                                                                   const SweepAttr& sweepAttr, bool is_weak) {
+  std::vector<SweepPoint> curve;
+  for (auto num_workers : sweepAttr.workers) {
+    SweepPoint point;
+    point.num_workers = num_workers;
+    point.size = is_weak ? sweepAttr.weak_size_per_worker * num_workers : sweepAttr.strong_size;
+    point.results = std::make_shared<PerfResults>();
+
+    auto task = factory(point.size, num_workers);
+    if (task) {
+      auto pointAttr = std::make_shared<PerfAttr>(*perfAttr);
+      pointAttr->num_workers = num_workers;
+      Perf perf(task);
+      if (sweepAttr.type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
+        perf.task_run(pointAttr, point.results);
+      } else {
+        perf.pipeline_run(pointAttr, point.results);
+      }
+    }
+    curve.push_back(std::move(point));
+  }
+
+  if (curve.empty()) return curve;
+  const auto& base = curve.front();
+  for (auto& point : curve) {
+    if (base.results->median_sec <= 0.0 || point.results->median_sec <= 0.0) continue;
+    auto workers_ratio = static_cast<double>(point.num_workers) / static_cast<double>(base.num_workers);
+    point.speedup = base.results->median_sec / point.results->median_sec;
+    if (is_weak) point.speedup *= workers_ratio;
+    point.efficiency = point.speedup / workers_ratio;
+  }
+  return curve;
+}
+
+void ppc::core::PerfSweep::print_sweep_statistic(const SweepResults& sweepResults) {
+  for (const auto& [name, curve] : {std::pair{"strong", &sweepResults.strong}, std::pair{"weak", &sweepResults.weak}}) {
+    for (const auto& point : *curve) {
+      std::ostringstream point_str;
+      point_str << name << ":" << point.size << ":" << point.num_workers << ":" << std::fixed << std::setprecision(10)
+                << point.results->median_sec << ":" << std::setprecision(4) << point.speedup << ":"
+                << point.efficiency;
+      std::cout << point_str.str() << std::endl;
+    }
+  }
+}
@@ -0,0 +1,185 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_writer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// empty for nan and infinity, it's written as null to JSON
+std::string number(double value) {
+  if (!std::isfinite(value)) return "";
+  std::ostringstream str;
+  str << std::setprecision(10) << value;
+  return str.str();
+}
+
+std::string number(const std::optional<uint64_t>& value) { return value ? std::to_string(*value) : std::string(); }
+
+// empty if the allocation profiler isn't linked
+std::string alloc_number(uint64_t value) { return ppc::core::AllocStats::enabled() ? std::to_string(value) : ""; }
+
+std::string json_escape(const std::string& str) {
+  std::ostringstream result;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      result << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      result << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+    } else {
+      result << c;
+    }
+  }
+  return result.str();
+}
+
+std::string csv_escape(const std::string& str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) return str;
+  std::string result = "\"";
+  for (char c : str) {
+    if (c == '"') result += '"';
+    result += c;
+  }
+  return result + "\"";
+}
+
+}  // namespace
+
+ppc::core::PerfWriter::PerfWriter(std::ostream& out_, Format format_) : out(out_), format(format_) {}
+
+std::vector<ppc::core::PerfWriter::Field> ppc::core::PerfWriter::fields(const PerfRecord& record) {
+  const auto& res = record.results;
+  return {{"task_id", record.task_id, true},
+          {"backend", record.backend, true},
+          {"type_of_running", record.type_of_running, true},
+          {"cache_mode", res.cache_mode == CacheMode::COLD ? "cold" : "warm", true},
+          {"affinity", Affinity::policy_name(res.affinity), true},
+          {"num_elements", std::to_string(res.num_elements), false},
+          {"num_workers", std::to_string(res.num_workers), false},
+          {"num_running", std::to_string(res.num_running), false},
+          {"time_sec", number(res.time_sec), false},
+          {"min_sec", number(res.min_sec), false},
+          {"max_sec", number(res.max_sec), false},
+          {"mean_sec", number(res.mean_sec), false},
+          {"median_sec", number(res.median_sec), false},
+          {"p95_sec", number(res.p95_sec), false},
+          {"p99_sec", number(res.p99_sec), false},
+          {"stddev_sec", number(res.stddev_sec), false},
+          {"ci_low_sec", number(res.ci_low_sec), false},
+          {"ci_high_sec", number(res.ci_high_sec), false},
+          {"outliers_count", std::to_string(res.outliers_count), false},
+          {"cycles", number(res.hw_counters.cycles), false},
+          {"instructions", number(res.hw_counters.instructions), false},
+          {"llc_misses", number(res.hw_counters.llc_misses), false},
+          {"branch_misses", number(res.hw_counters.branch_misses), false},
+          {"dtlb_misses", number(res.hw_counters.dtlb_misses), false},
+          {"ipc", number(res.ipc), false},
+          {"bytes_per_run", std::to_string(res.bytes_per_run), false},
+          {"ops_per_run", std::to_string(res.ops_per_run), false},
+          {"bandwidth_gbs", number(res.bandwidth_gbs), false},
+          {"gflops", number(res.gflops), false},
+          {"peak_bandwidth_gbs", number(res.peak_bandwidth_gbs), false},
+          {"peak_gflops", number(res.peak_gflops), false},
+          {"roofline_efficiency", number(res.roofline_efficiency), false},
+          {"allocations", alloc_number(res.alloc_stats.total().allocations), false},
+          {"allocated_bytes", alloc_number(res.alloc_stats.total().allocated_bytes), false},
+          {"peak_live_bytes", alloc_number(res.alloc_stats.total().peak_live_bytes), false},
+          {"comm_messages", std::to_string(res.comm_stats.total().messages), false},
+          {"comm_bytes", std::to_string(res.comm_stats.total().bytes), false},
+          {"comm_time_sec", number(res.comm_stats.total().time_sec), false},
+          {"comm_time_fraction", number(res.comm_time_fraction), false},
+          {"cpu_model", record.cpu_model, true},
+          {"cores_count", std::to_string(record.cores_count), false},
+          {"timestamp", std::to_string(record.timestamp), false}};
+}
+
+void ppc::core::PerfWriter::write_header() {
+  if (format != Format::CSV) return;
+  auto record_fields = fields(PerfRecord{});
+  for (size_t i = 0; i < record_fields.size(); i++) {
+    out << (i == 0 ? "" : ",") << record_fields[i].name;
+  }
+  out << std::endl;
+}
+
+void ppc::core::PerfWriter::write(const PerfRecord& record) {
+  auto record_fields = fields(record);
+  if (format == Format::CSV) {
+    for (size_t i = 0; i < record_fields.size(); i++) {
+      out << (i == 0 ? "" : ",") << csv_escape(record_fields[i].value);
+    }
+  } else {
+    out << "{";
+    for (size_t i = 0; i < record_fields.size(); i++) {
+      const auto& field = record_fields[i];
+      out << (i == 0 ? "" : ",") << "\"" << field.name << "\":";
+      if (field.is_string) {
+        out << "\"" << json_escape(field.value) << "\"";
+      } else {
+        out << (field.value.empty() ? "null" : field.value);
+      }
+    }
+    out << "}";
+  }
+  out << std::endl;
+}
+
+std::string ppc::core::PerfWriter::task_path(const std::string& test_file_path) {
+  std::vector<std::string> components(1);
+  for (char c : test_file_path) {
+    if (c == '/' || c == '\\') {
+      components.emplace_back();
+    } else {
+      components.back() += c;
+    }
+  }
+  for (size_t i = components.size(); i-- > 3;) {
+    if (components[i] == "perf_tests" && components[i - 3] == "tasks") {
+      return "tasks/" + components[i - 2] + "/" + components[i - 1];
+    }
+  }
+  return {};
+}
+
+std::string ppc::core::PerfWriter::type_of_running_name(PerfResults::TypeOfRunning type_of_running) {
+  if (type_of_running == PerfResults::TypeOfRunning::TASK_RUN) return "task_run";
+  if (type_of_running == PerfResults::TypeOfRunning::PIPELINE) return "pipeline";
+  return "none";
+}
+
+std::string ppc::core::PerfWriter::cpu_model() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 2 <= line.size()) return line.substr(pos + 2);
+    }
+  }
+  return "unknown";
+}
+
+ppc::core::PerfRecord ppc::core::PerfWriter::make_record(const std::string& test_file_path,
+                                                         const PerfResults& results) {
+  PerfRecord record;
+  auto path = task_path(test_file_path);
+  if (!path.empty()) {
+    auto backend_begin = path.find('/') + 1;
+    auto task_begin = path.find('/', backend_begin) + 1;
+    record.backend = path.substr(backend_begin, task_begin - backend_begin - 1);
+    record.task_id = path.substr(task_begin);
+  } else {
+    record.task_id = test_file_path;
+  }
+  record.type_of_running = type_of_running_name(results.type_of_running);
+  record.cpu_model = cpu_model();
+  record.cores_count = std::thread::hardware_concurrency();
+  record.timestamp =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  record.results = results;
+  return record;
+}
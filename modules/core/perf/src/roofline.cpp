@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/roofline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/perf/include/cache_flusher.hpp"
+
+namespace {
+
+constexpr int repetitions = 5;
+// arrays of triad are four times larger than the largest cache
+constexpr size_t cache_factor = 4;
+constexpr size_t default_bytes = 256 * 1024 * 1024;
+constexpr size_t max_bytes = 512 * 1024 * 1024;
+
+// Best time of repetitions of work(thread_index) run by all threads at once
+template <class Work>
+double best_parallel_time(size_t num_threads, Work work) {
+  double best_time = 0.0;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; i++) {
+      threads.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - begin;
+    if (repetition == 0 || time.count() < best_time) best_time = time.count();
+  }
+  return best_time;
+}
+
+}  // namespace
+
+ppc::core::MachinePeak ppc::core::Roofline::peak(size_t num_threads) {
+  static std::mutex mutex;
+  static std::map<size_t, MachinePeak> peaks;
+  num_threads = std::max<size_t>(num_threads, 1);
+  std::lock_guard lock(mutex);
+  auto it = peaks.find(num_threads);
+  if (it != peaks.end()) return it->second;
+
+  auto cache_size = CacheFlusher::largest_cache_size();
+  auto bytes = cache_size != 0 ? std::min(cache_factor * cache_size, max_bytes) : default_bytes;
+  MachinePeak machine_peak{measure_bandwidth(num_threads, bytes), measure_gflops(num_threads)};
+  peaks[num_threads] = machine_peak;
+  return machine_peak;
+}
+
+double ppc::core::Roofline::measure_bandwidth(size_t num_threads, size_t bytes) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  auto count = std::max<size_t>(bytes / (3 * sizeof(double)), num_threads);
+  std::vector<double> a(count, 0.0);
+  std::vector<double> b(count, 1.0);
+  std::vector<double> c(count, 2.0);
+  const double scalar = 3.0;
+  auto chunk = count / num_threads;
+  auto time = best_parallel_time(num_threads, [&](size_t thread_index) {
+    auto begin = thread_index * chunk;
+    auto end = thread_index + 1 == num_threads ? count : begin + chunk;
+    for (auto i = begin; i < end; i++) {
+      a[i] = b[i] + scalar * c[i];
+    }
+  });
+  // two reads and one write of every element
+  return time > 0.0 ? static_cast<double>(3 * count * sizeof(double)) / time * 1e-9 : 0.0;
+}
+
+double ppc::core::Roofline::measure_gflops(size_t num_threads) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  constexpr size_t chains = 32;
+  constexpr size_t iterations = 1 << 20;
+  // results are kept, so chains can't be optimized out
+  std::vector<double> results(num_threads);
+  auto time = best_parallel_time(num_threads, [&](size_t thread_index) {
+    std::array<double, chains> x{};
+    x.fill(static_cast<double>(thread_index));
+    for (size_t i = 0; i < iterations; i++) {
+      for (auto& value : x) {
+        value = value * 0.999999 + 1e-6;
+      }
+    }
+    double sum = 0.0;
+    for (auto value : x) {
+      sum += value;
+    }
+    results[thread_index] = sum;
+  });
+  // multiplication and addition for every chain on every iteration
+  auto flops = static_cast<double>(2 * chains * iterations * num_threads);
+  return time > 0.0 ? flops / time * 1e-9 : 0.0;
+}
+
+double ppc::core::Roofline::efficiency(const MachinePeak& machine_peak, uint64_t bytes, uint64_t ops,
+                                       double time_sec) {
+  if (time_sec <= 0.0) return 0.0;
+  auto bandwidth_gbs = static_cast<double>(bytes) / time_sec * 1e-9;
+  auto gflops = static_cast<double>(ops) / time_sec * 1e-9;
+  if (ops == 0) return machine_peak.bandwidth_gbs > 0.0 ? bandwidth_gbs / machine_peak.bandwidth_gbs : 0.0;
+  if (bytes == 0) return machine_peak.gflops > 0.0 ? gflops / machine_peak.gflops : 0.0;
+  auto intensity = static_cast<double>(ops) / static_cast<double>(bytes);
+  auto attainable_gflops = std::min(machine_peak.gflops, intensity * machine_peak.bandwidth_gbs);
+  return attainable_gflops > 0.0 ? gflops / attainable_gflops : 0.0;
+}
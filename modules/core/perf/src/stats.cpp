@@ -0,0 +1,103 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+double ppc::core::stats::mean(const std::vector<double>& samples) {
+  if (samples.empty()) return 0.0;
+  return std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+}
+
+double ppc::core::stats::stddev(const std::vector<double>& samples) {
+  if (samples.size() < 2) return 0.0;
+  auto avg = mean(samples);
+  double sum_sq = 0.0;
+  for (auto sample : samples) {
+    sum_sq += (sample - avg) * (sample - avg);
+  }
+  return std::sqrt(sum_sq / static_cast<double>(samples.size() - 1));
+}
+
+double ppc::core::stats::quantile(const std::vector<double>& sorted, double q) {
+  if (sorted.empty()) return 0.0;
+  auto pos = q * static_cast<double>(sorted.size() - 1);
+  auto lower = static_cast<size_t>(std::floor(pos));
+  auto upper = static_cast<size_t>(std::ceil(pos));
+  auto frac = pos - static_cast<double>(lower);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * frac;
+}
+
+double ppc::core::stats::student_t95(size_t degrees_of_freedom) {
+  static constexpr std::array<double, 30> table = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+  // larger degrees of freedom: linear interpolation in 1 / dof, 0 is infinity
+  static constexpr std::array<std::pair<double, double>, 5> tail = {
+      {{30.0, 2.042}, {40.0, 2.021}, {60.0, 2.000}, {120.0, 1.980}, {0.0, 1.960}}};
+  if (degrees_of_freedom == 0) return 0.0;
+  if (degrees_of_freedom <= table.size()) return table[degrees_of_freedom - 1];
+  auto inverse = 1.0 / static_cast<double>(degrees_of_freedom);
+  for (size_t i = 1; i < tail.size(); i++) {
+    auto upper_inverse = tail[i].first > 0.0 ? 1.0 / tail[i].first : 0.0;
+    if (inverse >= upper_inverse) {
+      auto lower_inverse = 1.0 / tail[i - 1].first;
+      auto frac = (lower_inverse - inverse) / (lower_inverse - upper_inverse);
+      return tail[i - 1].second + (tail[i].second - tail[i - 1].second) * frac;
+    }
+  }
+  return tail.back().second;
+}
+
+std::vector<double> ppc::core::stats::reject_outliers(const std::vector<double>& sorted) {
+  auto q1 = quantile(sorted, 0.25);
+  auto q3 = quantile(sorted, 0.75);
+  auto iqr = q3 - q1;
+  std::vector<double> result;
+  result.reserve(sorted.size());
+  for (auto sample : sorted) {
+    if (sample >= q1 - 1.5 * iqr && sample <= q3 + 1.5 * iqr) {
+      result.push_back(sample);
+    }
+  }
+  return result;
+}
+
+double ppc::core::stats::mann_whitney_p(const std::vector<double>& a, const std::vector<double>& b) {
+  if (a.empty() || b.empty()) return 1.0;
+  // Ranks of pooled samples, tied values get the mean of their ranks
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(a.size() + b.size());
+  for (auto sample : a) pooled.emplace_back(sample, true);
+  for (auto sample : b) pooled.emplace_back(sample, false);
+  std::sort(pooled.begin(), pooled.end());
+
+  double rank_sum_a = 0.0;
+  double ties_term = 0.0;
+  for (size_t i = 0; i < pooled.size();) {
+    auto j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) j++;
+    auto mean_rank = static_cast<double>(i + j + 1) / 2.0;
+    for (auto k = i; k < j; k++) {
+      if (pooled[k].second) rank_sum_a += mean_rank;
+    }
+    auto ties = static_cast<double>(j - i);
+    ties_term += ties * ties * ties - ties;
+    i = j;
+  }
+
+  auto n_a = static_cast<double>(a.size());
+  auto n_b = static_cast<double>(b.size());
+  auto n = n_a + n_b;
+  auto u = rank_sum_a - n_a * (n_a + 1) / 2.0;
+  auto mean_u = n_a * n_b / 2.0;
+  auto variance_u = n_a * n_b / 12.0 * ((n + 1) - ties_term / (n * (n - 1)));
+  if (variance_u <= 0.0) return 1.0;
+  // continuity correction
+  auto z = std::max(0.0, std::abs(u - mean_u) - 0.5) / std::sqrt(variance_u);
+  return std::erfc(z / std::sqrt(2.0));
+}
@@ -0,0 +1,139 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/pool/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, check_parallel_for_visits_every_index_once) {
+  ppc::core::ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(1001);
+  ppc::core::parallel_for(
+      0, visits.size(),
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) visits[i]++;
+      },
+      10, pool);
+  for (auto &count : visits) ASSERT_EQ(count, 1);
+
+  // empty range
+  ppc::core::parallel_for(5, 5, [](size_t, size_t) { FAIL(); }, 1, pool);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce) {
+  std::vector<int64_t> values(100000);
+  std::iota(values.begin(), values.end(), 1);
+  auto sum_of_chunk = [&](size_t begin, size_t end) {
+    return std::accumulate(values.begin() + begin, values.begin() + end, int64_t{0});
+  };
+  auto sum = ppc::core::parallel_reduce(0, values.size(), int64_t{0}, sum_of_chunk,
+                                        [](int64_t lhs, int64_t rhs) { return lhs + rhs; });
+  ASSERT_EQ(sum, int64_t{100000} * 100001 / 2);
+
+  // partial results are reduced in order of chunks
+  ppc::core::ThreadPool pool(2);
+  auto order = ppc::core::parallel_reduce(
+      0, 10, std::vector<size_t>(), [](size_t begin, size_t) { return std::vector<size_t>{begin}; },
+      [](std::vector<size_t> lhs, const std::vector<size_t> &rhs) {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+      },
+      1, pool);
+  ASSERT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(thread_pool_tests, check_parallel_invoke) {
+  int first = 0;
+  int second = 0;
+  int third = 0;
+  ppc::core::parallel_invoke([&] { first = 1; }, [&] { second = 2; }, [&] { third = 3; });
+  ASSERT_EQ(first + second + third, 6);
+}
+
+TEST(thread_pool_tests, check_jobs_run_concurrently) {
+  ppc::core::ThreadPool pool(3);
+  ASSERT_EQ(pool.size(), 3U);
+  std::atomic<int> started = 0;
+  std::atomic<bool> is_timed_out = false;
+  pool.run(4, [&](size_t) {
+    started++;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (started.load() < 4 && !is_timed_out) {
+      if (std::chrono::steady_clock::now() > deadline) is_timed_out = true;
+      std::this_thread::yield();
+    }
+  });
+  ASSERT_FALSE(is_timed_out);
+}
+
+TEST(thread_pool_tests, check_nested_parallel_calls) {
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> count = 0;
+  ppc::core::parallel_for(
+      0, 8,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          ppc::core::parallel_for(0, 100, [&](size_t b, size_t e) { count += static_cast<int>(e - b); }, 1, pool);
+        }
+      },
+      1, pool);
+  ASSERT_EQ(count, 800);
+}
+
+TEST(thread_pool_tests, check_exception_is_rethrown) {
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> finished = 0;
+  ASSERT_THROW(pool.run(10,
+                        [&](size_t i) {
+                          finished++;
+                          if (i == 7) throw std::runtime_error("job error");
+                        }),
+               std::runtime_error);
+  ASSERT_EQ(finished, 10);
+}
+
+TEST(thread_pool_tests, check_pin_workers) {
+  ppc::core::ThreadPool pool(2);
+  pool.pin_workers();
+  std::atomic<int> count = 0;
+  pool.run(6, [&](size_t) { count++; });
+  ASSERT_EQ(count, 6);
+}
+
+TEST(thread_pool_tests, check_resize) {
+  ppc::core::ThreadPool pool(1);
+  for (size_t num_threads : {3, 0, 2}) {
+    pool.resize(num_threads);
+    ASSERT_EQ(pool.size(), num_threads);
+    std::atomic<int> count = 0;
+    ppc::core::parallel_for(0, 100, [&](size_t begin, size_t end) { count += static_cast<int>(end - begin); }, 1, pool);
+    ASSERT_EQ(count, 100);
+  }
+}
+
+TEST(thread_pool_tests, check_caller_runs_jobs_of_every_queue) {
+  // Only the calling thread runs jobs: jobs spread over both queues of a pool
+  // whose worker is blocked until all other jobs are done
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> count = 0;
+  std::atomic<bool> is_released = false;
+  std::atomic<int> blocked = 0;
+  auto block = [&] {
+    blocked++;
+    while (!is_released) std::this_thread::yield();
+  };
+  pool.submit(block);
+  pool.submit(block);
+  while (blocked.load() < 2) std::this_thread::yield();
+  for (int i = 0; i < 10; i++) pool.submit([&] { count++; });
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  pool.help_until([&] { return count.load() == 10 || std::chrono::steady_clock::now() > deadline; });
+  is_released = true;
+  ASSERT_EQ(count, 10);
+}
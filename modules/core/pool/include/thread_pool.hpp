@@ -0,0 +1,134 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
+#define MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+// Work-stealing pool: every worker has its own deque of jobs, takes the newest
+// job from it and steals the oldest ones from other workers when it's empty.
+// Threads are created once, so parallel calls cost a few queue operations.
+// Thread waiting for its jobs runs jobs of the pool meanwhile, so parallel
+// calls can be nested.
+class ThreadPool {
+ public:
+  // count of hardware threads minus the calling one if num_threads is 0
+  explicit ThreadPool(size_t num_threads = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // process-wide pool shared by all thread-based backends
+  static ThreadPool& instance();
+
+  // count of worker threads; parallel calls also use the calling thread
+  [[nodiscard]] size_t size() const { return threads.size(); }
+
+  // replace workers with num_threads new ones (0 leaves only calling threads),
+  // e.g. for a sweep over counts of threads; it must not be called while jobs
+  // of the pool run
+  void resize(size_t num_threads);
+
+  // run job(0), ..., job(count - 1) in parallel and wait for them; the first
+  // exception thrown by a job is rethrown after all jobs finish
+  void run(size_t count, const std::function<void(size_t)>& job);
+
+  // run job on a thread of the pool; job must not throw. Jobs submitted by a
+  // worker go to its own queue.
+  void submit(std::function<void()> job);
+
+  // run jobs of the pool on the calling thread till is_done() returns true;
+  // threads waiting for submitted jobs use it instead of blocking, so nested
+  // parallel calls of the jobs still get help
+  void help_until(const std::function<bool()>& is_done);
+
+  // pin workers by current policy of Affinity before their next jobs (the
+  // calling thread is worker 0); it is used as PerfAttr::pin_workers. New
+  // workers are pinned by the policy current at their start.
+  void pin_workers();
+
+ private:
+  using Job = std::function<void()>;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  void start(size_t num_threads);
+  void stop();
+  void push(Job job);
+  bool try_run_one(size_t own_index);
+  void worker_loop(size_t index);
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> queued_count = 0;
+  std::atomic<size_t> next_queue = 0;
+  std::atomic<size_t> pin_generation = 0;
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_cv;
+  bool is_stopped = false;
+};
+
+// Count of chunks for count iterations with at least grain iterations in a
+// chunk: a few chunks per thread to balance uneven work by stealing
+inline size_t parallel_chunks_count(size_t count, size_t grain, const ThreadPool& pool) {
+  if (count == 0) return 0;
+  size_t max_chunks = (count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1);
+  return std::max<size_t>(1, std::min(max_chunks, 4 * (pool.size() + 1)));
+}
+
+// body(chunk_begin, chunk_end) for contiguous chunks of [begin, end)
+template <class Body>
+void parallel_for(size_t begin, size_t end, Body&& body, size_t grain = 1,
+                  ThreadPool& pool = ThreadPool::instance()) {
+  if (end <= begin) return;
+  size_t count = end - begin;
+  size_t chunks = parallel_chunks_count(count, grain, pool);
+  pool.run(chunks, [&](size_t chunk) {
+    body(begin + count * chunk / chunks, begin + count * (chunk + 1) / chunks);
+  });
+}
+
+// reduce(identity, map(chunk_begin, chunk_end)) over contiguous chunks of
+// [begin, end); partial results are reduced in order of chunks, so result
+// doesn't depend on scheduling
+template <class T, class Map, class Reduce>
+T parallel_reduce(size_t begin, size_t end, T identity, Map&& map, Reduce&& reduce, size_t grain = 1,
+                  ThreadPool& pool = ThreadPool::instance()) {
+  if (end <= begin) return identity;
+  size_t count = end - begin;
+  size_t chunks = parallel_chunks_count(count, grain, pool);
+  std::vector<T> partial(chunks, identity);
+  pool.run(chunks, [&](size_t chunk) {
+    partial[chunk] = map(begin + count * chunk / chunks, begin + count * (chunk + 1) / chunks);
+  });
+  T result = identity;
+  for (auto& value : partial) result = reduce(std::move(result), std::move(value));
+  return result;
+}
+
+// run functions in parallel and wait for them
+template <class... Functions>
+void parallel_invoke(Functions&&... functions) {
+  std::array<std::function<void()>, sizeof...(Functions)> jobs = {std::function<void()>(functions)...};
+  ThreadPool::instance().run(jobs.size(), [&](size_t i) { jobs[i](); });
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
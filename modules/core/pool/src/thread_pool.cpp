@@ -0,0 +1,149 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/pool/include/thread_pool.hpp"
+
+#include <exception>
+#include <limits>
+#include <utility>
+
+#include "core/perf/include/affinity.hpp"
+
+namespace {
+
+// pool and queue index of the calling worker thread
+thread_local ppc::core::ThreadPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+
+constexpr size_t no_queue = std::numeric_limits<size_t>::max();
+
+}  // namespace
+
+ppc::core::ThreadPool::ThreadPool(size_t num_threads) {
+  if (num_threads == 0) num_threads = std::max(1U, std::thread::hardware_concurrency()) - 1;
+  start(num_threads);
+}
+
+ppc::core::ThreadPool::~ThreadPool() { stop(); }
+
+void ppc::core::ThreadPool::resize(size_t num_threads) {
+  stop();
+  start(num_threads);
+}
+
+void ppc::core::ThreadPool::start(size_t num_threads) {
+  is_stopped = false;
+  // a pool without workers keeps jobs in one queue for helping threads
+  queues.clear();
+  for (size_t i = 0; i < std::max<size_t>(num_threads, 1); i++) queues.push_back(std::make_unique<Queue>());
+  for (size_t i = 0; i < num_threads; i++) threads.emplace_back([this, i] { worker_loop(i); });
+}
+
+void ppc::core::ThreadPool::stop() {
+  {
+    std::lock_guard lock(sleep_mutex);
+    is_stopped = true;
+  }
+  sleep_cv.notify_all();
+  for (auto& thread : threads) thread.join();
+  threads.clear();
+}
+
+ppc::core::ThreadPool& ppc::core::ThreadPool::instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ppc::core::ThreadPool::push(Job job) {
+  // workers push into their own queues, other threads spread jobs over queues
+  size_t index = current_pool == this ? current_index : next_queue.fetch_add(1) % queues.size();
+  queued_count.fetch_add(1);
+  {
+    std::lock_guard lock(queues[index]->mutex);
+    queues[index]->jobs.push_back(std::move(job));
+  }
+  // the lock orders the notification after the check of a waiting worker
+  { std::lock_guard lock(sleep_mutex); }
+  sleep_cv.notify_one();
+}
+
+bool ppc::core::ThreadPool::try_run_one(size_t own_index) {
+  Job job;
+  if (own_index != no_queue) {
+    auto& queue = *queues[own_index];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    }
+  }
+  for (size_t k = 0; !job && k < queues.size(); k++) {
+    auto& queue = *queues[(own_index == no_queue ? k : own_index + 1 + k) % queues.size()];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+  }
+  if (!job) return false;
+  queued_count.fetch_sub(1);
+  job();
+  return true;
+}
+
+void ppc::core::ThreadPool::worker_loop(size_t index) {
+  current_pool = this;
+  current_index = index;
+  // a new worker inherits CPU mask of the thread creating it, so it's pinned
+  // by the current policy first
+  size_t pinned_generation = pin_generation.load() - 1;
+  while (true) {
+    auto generation = pin_generation.load();
+    if (generation != pinned_generation) {
+      Affinity::pin_worker(index + 1);
+      pinned_generation = generation;
+    }
+    if (try_run_one(index)) continue;
+
+    std::unique_lock lock(sleep_mutex);
+    sleep_cv.wait(lock, [&] {
+      return is_stopped || queued_count.load() > 0 || pin_generation.load() != pinned_generation;
+    });
+    if (is_stopped && queued_count.load() == 0) return;
+  }
+}
+
+void ppc::core::ThreadPool::run(size_t count, const std::function<void(size_t)>& job) {
+  std::atomic<size_t> left_count = count;
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+  auto execute = [&](size_t i) {
+    try {
+      job(i);
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!first_error) first_error = std::current_exception();
+    }
+    left_count.fetch_sub(1);
+  };
+
+  if (count > 0) {
+    for (size_t i = 1; i < count; i++) push([&execute, i] { execute(i); });
+    execute(0);
+    help_until([&] { return left_count.load() == 0; });
+  }
+  if (first_error) std::rethrow_exception(first_error);
+}
+
+void ppc::core::ThreadPool::submit(std::function<void()> job) { push(std::move(job)); }
+
+void ppc::core::ThreadPool::help_until(const std::function<bool()>& is_done) {
+  size_t own_index = current_pool == this ? current_index : no_queue;
+  while (!is_done()) {
+    if (!try_run_one(own_index)) std::this_thread::yield();
+  }
+}
+
+void ppc::core::ThreadPool::pin_workers() {
+  pin_generation.fetch_add(1);
+  { std::lock_guard lock(sleep_mutex); }
+  sleep_cv.notify_all();
+}
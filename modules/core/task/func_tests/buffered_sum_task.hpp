@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTS_BUFFERED_SUM_TASK_HPP_
+#define MODULES_CORE_TESTS_BUFFERED_SUM_TASK_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::test {
+
+// Sum of input kept in internal buffer refilled by every pre_processing()
+class BufferedSumTask : public ppc::core::Task {
+ public:
+  explicit BufferedSumTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+
+  bool validation() override {
+    internal_order_test();
+    validations_count++;
+    return taskData->outputs_count[0] == 1;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    auto input = taskData->input_as<const int32_t>(0);
+    buffer.assign(input.begin(), input.end());
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    sum = 0;
+    for (auto value : buffer) sum += value;
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    taskData->output_as<int32_t>(0)[0] = sum;
+    return true;
+  }
+
+  int validations_count = 0;
+
+ private:
+  std::vector<int32_t> buffer;
+  int32_t sum = 0;
+};
+
+inline std::shared_ptr<ppc::core::TaskData> make_task_data(std::vector<int32_t> &in, std::vector<int32_t> &out) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  return taskData;
+}
+
+
+}  // namespace ppc::test
+
+#endif  // MODULES_CORE_TESTS_BUFFERED_SUM_TASK_HPP_
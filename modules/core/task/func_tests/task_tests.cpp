@@ -1,11 +1,17 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <thread>
 #include <vector>
 
+#include "core/task/func_tests/buffered_sum_task.hpp"
 #include "core/task/func_tests/test_task.hpp"
 #include "core/task/include/task.hpp"
 
+using ppc::test::BufferedSumTask;
+using ppc::test::make_task_data;
+
 TEST(task_tests, check_int32_t) {
   // Create data
   std::vector<int32_t> in(20, 1);
@@ -154,6 +160,185 @@ TEST(task_tests, check_wrong_order) {
   ASSERT_ANY_THROW(testTask.post_processing());
 }
 
+TEST(task_tests, check_many_pipeline_cycles) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  for (int i = 0; i < 10000; i++) {
+    ASSERT_EQ(testTask.validation(), true);
+    testTask.pre_processing();
+    testTask.run();
+    testTask.run();
+    testTask.post_processing();
+  }
+  ASSERT_EQ(testTask.get_current_phase(), ppc::core::Task::Phase::POST_PROCESSING);
+  ASSERT_ANY_THROW(testTask.run());
+}
+
+TEST(task_tests, check_phase_time_points) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.get_current_phase(), ppc::core::Task::Phase::NONE);
+  testTask.validation();
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  using Phase = ppc::core::Task::Phase;
+  ASSERT_LE(testTask.get_phase_time_point(Phase::VALIDATION), testTask.get_phase_time_point(Phase::PRE_PROCESSING));
+  ASSERT_LE(testTask.get_phase_time_point(Phase::PRE_PROCESSING), testTask.get_phase_time_point(Phase::RUN));
+  ASSERT_LE(testTask.get_phase_time_point(Phase::RUN), testTask.get_phase_time_point(Phase::POST_PROCESSING));
+  ASSERT_ANY_THROW(static_cast<void>(testTask.get_phase_time_point(Phase::NONE)));
+}
+
+TEST(task_tests, check_typed_views) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto input = taskData->input_as<const int32_t>(0);
+  auto output = taskData->output_as<int32_t>(0);
+  ASSERT_EQ(input.data(), in.data());
+  ASSERT_EQ(input.size(), in.size());
+  ASSERT_EQ(output.data(), out.data());
+  ASSERT_EQ(output.size(), out.size());
+  ASSERT_ANY_THROW(static_cast<void>(taskData->input_as<int32_t>(1)));
+  ASSERT_ANY_THROW(static_cast<void>(taskData->output_as<int32_t>(1)));
+}
+
+TEST(task_tests, check_input_view_of_not_borrowed_input) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+
+  std::vector<int32_t> storage;
+  ASSERT_EQ(taskData->input_view<int32_t>(0, storage).data(), in.data());
+  ASSERT_TRUE(storage.empty());
+
+  taskData->inputs_borrowed = false;
+  auto input = taskData->input_view<int32_t>(0, storage);
+  in[0] = 2;
+  ASSERT_EQ(input.data(), storage.data());
+  ASSERT_EQ(input.size(), in.size());
+  ASSERT_EQ(input[0], 1);
+}
+
+TEST(task_tests, check_set_validated_data) {
+  // Create data
+  std::vector<int32_t> first(10, 1);
+  std::vector<int32_t> second(10, 2);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  auto make_task_data = [&](std::vector<int32_t> &in) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    taskData->inputs_count.emplace_back(in.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskData->outputs_count.emplace_back(out.size());
+    return taskData;
+  };
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(make_task_data(first));
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out[0], 10);
+
+  // Pipeline continues from pre_processing
+  testTask.set_validated_data(make_task_data(second));
+  ASSERT_EQ(testTask.get_current_phase(), ppc::core::Task::Phase::VALIDATION);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out[0], 20);
+}
+
+TEST(task_tests, check_rebind_caches_validation) {
+  std::vector<int32_t> first(10, 1);
+  std::vector<int32_t> second(10, 2);
+  std::vector<int32_t> longer(15, 3);
+  std::vector<int32_t> out(1, 0);
+
+  std::vector<int32_t> wrong_out(2, 0);
+
+  BufferedSumTask task(make_task_data(first, out));
+  // Pipeline run without rebind() doesn't fill the cache
+  ASSERT_TRUE(task.validation() && task.pre_processing() && task.run() && task.post_processing());
+  ASSERT_TRUE(task.rebind(make_task_data(first, out)));
+  ASSERT_EQ(task.validations_count, 2);
+  ASSERT_TRUE(task.pre_processing() && task.run() && task.post_processing());
+  ASSERT_EQ(out[0], 10);
+
+  // The same shape skips validation
+  ASSERT_TRUE(task.rebind(make_task_data(second, out)));
+  ASSERT_TRUE(task.pre_processing() && task.run() && task.post_processing());
+  ASSERT_EQ(out[0], 20);
+  ASSERT_EQ(task.validations_count, 2);
+
+  // Another shape is validated again
+  ASSERT_TRUE(task.rebind(make_task_data(longer, out)));
+  ASSERT_EQ(task.validations_count, 3);
+  ASSERT_TRUE(task.pre_processing() && task.run() && task.post_processing());
+  ASSERT_EQ(out[0], 45);
+
+  // Shape which failed validation isn't cached
+  ASSERT_FALSE(task.rebind(make_task_data(first, wrong_out)));
+  ASSERT_FALSE(task.rebind(make_task_data(first, wrong_out)));
+  ASSERT_EQ(task.validations_count, 5);
+}
+
+TEST(task_tests, check_active_phase_ends_with_pipeline) {
+  std::vector<int32_t> in(10, 1);
+  std::vector<int32_t> out(1, 0);
+  BufferedSumTask task(make_task_data(in, out));
+  ASSERT_TRUE(task.validation() && task.pre_processing() && task.run());
+  ASSERT_EQ(ppc::core::Task::get_active_phase(), ppc::core::Task::Phase::RUN);
+
+  // Active phase belongs to the calling thread
+  auto other_thread_phase = ppc::core::Task::Phase::RUN;
+  std::thread([&] { other_thread_phase = ppc::core::Task::get_active_phase(); }).join();
+  ASSERT_EQ(other_thread_phase, ppc::core::Task::Phase::NONE);
+
+  ASSERT_TRUE(task.post_processing());
+  task.end_trace_phase();
+  ASSERT_EQ(ppc::core::Task::get_active_phase(), ppc::core::Task::Phase::NONE);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
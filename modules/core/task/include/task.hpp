@@ -3,11 +3,15 @@
 #ifndef MODULES_CORE_INCLUDE_TASK_HPP_
 #define MODULES_CORE_INCLUDE_TASK_HPP_
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ppc::core {
@@ -18,17 +22,72 @@ struct TaskData {
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting { FUNC, PERF } state_of_testing;
+  // caller keeps memory of inputs alive and unchanged until post_processing(),
+  // so task can read it in place instead of copying
+  bool inputs_borrowed = true;
+
+  // typed view of i-th input with inputs_count[i] elements
+  template <class T>
+  [[nodiscard]] std::span<T> input_as(size_t i) const {
+    return view_as<T>(inputs, inputs_count, i, "input");
+  }
+
+  // typed view of i-th output with outputs_count[i] elements
+  template <class T>
+  [[nodiscard]] std::span<T> output_as(size_t i) const {
+    return view_as<T>(outputs, outputs_count, i, "output");
+  }
+
+  // view of i-th input which stays valid until post_processing(): memory of
+  // caller if inputs are borrowed, otherwise a copy of it kept in storage
+  template <class T>
+  std::span<const T> input_view(size_t i, std::vector<T> &storage) const {
+    auto input = input_as<const T>(i);
+    if (inputs_borrowed) return input;
+    storage.assign(input.begin(), input.end());
+    return storage;
+  }
+
+ private:
+  template <class T>
+  static std::span<T> view_as(const std::vector<uint8_t *> &buffers, const std::vector<std::uint32_t> &counts,
+                              size_t i, const char *kind) {
+    if (i >= buffers.size() || i >= counts.size()) {
+      throw std::out_of_range("TaskData has no " + std::string(kind) + " with index " + std::to_string(i));
+    }
+    return {reinterpret_cast<T *>(buffers[i]), counts[i]};
+  }
 };
 
 // Memory of inputs and outputs need to be initialized before create object of
 // Task class
 class Task {
  public:
+  // phases of task's pipeline in the order they have to be called
+  enum class Phase : uint8_t { VALIDATION, PRE_PROCESSING, RUN, POST_PROCESSING, NONE };
+  using TimePoint = std::chrono::high_resolution_clock::time_point;
+
   explicit Task(std::shared_ptr<TaskData> taskData_);
 
   // set input and output data
   void set_data(std::shared_ptr<TaskData> taskData_);
 
+  // set data with the same layout (counts of inputs and outputs) as data which
+  // passed validation(), so the pipeline continues from pre_processing()
+  // without validation; task must not keep state computed by validation()
+  void set_validated_data(std::shared_ptr<TaskData> taskData_);
+
+  // Rebind task to new data for the next pipeline run without reconstruction:
+  // internal buffers of the task (and communicators of MPI tasks) are kept.
+  // rebind() calls validation() itself and returns its result; the pipeline
+  // continues from pre_processing() if it's true. Validation is cached by
+  // counts of inputs and outputs only: data with the same counts as the last
+  // data validated by rebind() is not validated again, so checks of contents
+  // of inputs in validation() are skipped for it. Tasks which refill buffers
+  // with assign() or resize() in pre_processing() reuse their capacity, so
+  // steady-state runs of rebound tasks don't allocate.
+  bool rebind(std::shared_ptr<TaskData> taskData_);
+
   // validation of data and validation of task attributes before running
   virtual bool validation() = 0;
 
@@ -41,20 +100,54 @@ class Task {
   // post-processing of output data
   virtual bool post_processing() = 0;
 
+  // count of bytes read and written by one run() for roofline analysis, 0 if
+  // it's not declared by the task
+  [[nodiscard]] virtual uint64_t bytes_per_run() const { return 0; }
+
+  // count of arithmetic operations of one run() for roofline analysis, 0 if
+  // it's not declared by the task
+  [[nodiscard]] virtual uint64_t ops_per_run() const { return 0; }
+
   // get input and output data
   [[nodiscard]] std::shared_ptr<TaskData> get_data() const;
 
+  // get the last entered phase of the pipeline
+  [[nodiscard]] Phase get_current_phase() const;
+
+  // get time point of the last entry into the phase
+  [[nodiscard]] TimePoint get_phase_time_point(Phase phase) const;
+
+  // get the phase of the task running on the calling thread, NONE outside of
+  // tasks; work of other threads started by the task is outside of tasks
+  static Phase get_active_phase();
+
+  // end the current phase: its event in trace and the active phase of the
+  // calling thread. It also ends when the next phase starts or the task is
+  // destroyed; callers end the pipeline with it after post_processing().
+  void end_trace_phase();
+
   virtual ~Task();
 
  protected:
-  void internal_order_test(const std::string &str = __builtin_FUNCTION());
+  void internal_order_test(std::string_view str = __builtin_FUNCTION());
   std::shared_ptr<TaskData> taskData;
 
  private:
-  std::vector<std::string> functions_order;
-  std::vector<std::string> right_functions_order = {"validation", "pre_processing", "run", "post_processing"};
+  static constexpr size_t phases_count = static_cast<size_t>(Phase::NONE);
+  static constexpr std::array<std::string_view, phases_count> phases_names = {"validation", "pre_processing", "run",
+                                                                              "post_processing"};
+  static Phase phase_by_name(std::string_view str);
+
+  Phase current_phase = Phase::NONE;
+  Phase traced_phase = Phase::NONE;
+  uint64_t phases_calls_count = 0;
+  std::array<TimePoint, phases_count> phases_time_points{};
+  // counts of inputs and outputs of the last data which passed validation() in
+  // rebind()
+  bool has_validated_shape = false;
+  std::vector<std::uint32_t> validated_inputs_count;
+  std::vector<std::uint32_t> validated_outputs_count;
   const double max_test_time = 1.0;
-  std::chrono::high_resolution_clock::time_point tmp_time_point;
 };
 
 }  // namespace ppc::core
@@ -6,36 +6,107 @@
 #include <stdexcept>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+
+namespace {
+// phase of the task which runs on the calling thread, so concurrent tasks
+// don't account work of each other
+thread_local ppc::core::Task::Phase active_phase = ppc::core::Task::Phase::NONE;
+thread_local const ppc::core::Task* active_task = nullptr;
+}  // namespace
+
 void ppc::core::Task::set_data(std::shared_ptr<TaskData> taskData_) {
   taskData_->state_of_testing = TaskData::StateOfTesting::FUNC;
-  functions_order.clear();
+  current_phase = Phase::NONE;
+  phases_calls_count = 0;
+  phases_time_points.fill(TimePoint{});
   taskData = std::move(taskData_);
 }
 
+void ppc::core::Task::set_validated_data(std::shared_ptr<TaskData> taskData_) {
+  set_data(std::move(taskData_));
+  current_phase = Phase::VALIDATION;
+}
+
+bool ppc::core::Task::rebind(std::shared_ptr<TaskData> taskData_) {
+  if (has_validated_shape && taskData_->inputs_count == validated_inputs_count &&
+      taskData_->outputs_count == validated_outputs_count) {
+    set_validated_data(std::move(taskData_));
+    return true;
+  }
+  set_data(std::move(taskData_));
+  if (!validation()) return false;
+  // assignment reuses capacity of the vectors
+  validated_inputs_count = taskData->inputs_count;
+  validated_outputs_count = taskData->outputs_count;
+  has_validated_shape = true;
+  return true;
+}
+
 std::shared_ptr<ppc::core::TaskData> ppc::core::Task::get_data() const { return taskData; }
 
+ppc::core::Task::Phase ppc::core::Task::get_current_phase() const { return current_phase; }
+
+ppc::core::Task::TimePoint ppc::core::Task::get_phase_time_point(Phase phase) const {
+  if (phase == Phase::NONE) {
+    throw std::invalid_argument("Phase NONE has no time point");
+  }
+  return phases_time_points[static_cast<size_t>(phase)];
+}
+
+ppc::core::Task::Phase ppc::core::Task::get_active_phase() { return active_phase; }
+
+void ppc::core::Task::end_trace_phase() {
+  if (active_task == this) {
+    active_phase = Phase::NONE;
+    active_task = nullptr;
+  }
+  if (traced_phase == Phase::NONE) return;
+  Tracer::instance().end(phases_names[static_cast<size_t>(traced_phase)], "phase");
+  traced_phase = Phase::NONE;
+}
+
 ppc::core::Task::Task(std::shared_ptr<TaskData> taskData_) { set_data(std::move(taskData_)); }
 
-void ppc::core::Task::internal_order_test(const std::string& str) {
-  if (!functions_order.empty() && str == functions_order.back() && str == "run") return;
+ppc::core::Task::Phase ppc::core::Task::phase_by_name(std::string_view str) {
+  for (size_t i = 0; i < phases_count; i++) {
+    if (phases_names[i] == str) return static_cast<Phase>(i);
+  }
+  return Phase::NONE;
+}
 
-  functions_order.push_back(str);
+void ppc::core::Task::internal_order_test(std::string_view str) {
+  auto phase = phase_by_name(str);
+  if (phase == Phase::RUN && current_phase == Phase::RUN) return;
 
-  for (size_t i = 0; i < functions_order.size(); i++) {
-    if (functions_order[i] != right_functions_order[i % right_functions_order.size()]) {
-      throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
-                                  std::to_string(i + 1) + "\n" + std::string("Yours function: ") + functions_order[i] +
-                                  "\n" + std::string("Expected function: ") + right_functions_order[i]);
-    }
+  auto expected_phase = (current_phase == Phase::NONE || current_phase == Phase::POST_PROCESSING)
+                            ? Phase::VALIDATION
+                            : static_cast<Phase>(static_cast<size_t>(current_phase) + 1);
+  if (phase != expected_phase) {
+    throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
+                                std::to_string(phases_calls_count + 1) + "\n" + std::string("Yours function: ") +
+                                std::string(str) + "\n" + std::string("Expected function: ") +
+                                std::string(phases_names[static_cast<size_t>(expected_phase)]));
   }
 
-  if (str == "pre_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
-    tmp_time_point = std::chrono::high_resolution_clock::now();
+  end_trace_phase();
+  if (Tracer::instance().enabled()) {
+    Tracer::instance().begin(phases_names[static_cast<size_t>(phase)], "phase");
+    traced_phase = phase;
   }
 
-  if (str == "post_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - tmp_time_point).count();
+  current_phase = phase;
+  active_phase = phase;
+  active_task = this;
+
+  phases_calls_count++;
+  auto now = std::chrono::high_resolution_clock::now();
+  phases_time_points[static_cast<size_t>(phase)] = now;
+
+  if (phase == Phase::POST_PROCESSING && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        now - phases_time_points[static_cast<size_t>(Phase::PRE_PROCESSING)])
+                        .count();
     auto current_time = static_cast<double>(duration) * 1e-9;
     if (current_time > max_test_time) {
       std::cerr << "Current test work more than " << max_test_time << " secs: " << current_time << std::endl;
@@ -44,4 +115,4 @@ void ppc::core::Task::internal_order_test(const std::string& str) {
   }
 }
 
-ppc::core::Task::~Task() { functions_order.clear(); }
+ppc::core::Task::~Task() { end_trace_phase(); }
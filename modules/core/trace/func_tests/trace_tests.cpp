@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+class TraceTestTask : public ppc::core::Task {
+ public:
+  explicit TraceTestTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool validation() override {
+    internal_order_test();
+    return true;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    ppc::core::TraceRegion region("compute");
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(trace_tests, check_task_phases_events) {
+  auto& tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable(3);
+  {
+    TraceTestTask task(std::make_shared<ppc::core::TaskData>());
+    task.validation();
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+  }
+  tracer.disable();
+
+  auto events = tracer.events();
+  tracer.clear();
+  std::vector<std::string> expected = {"Bvalidation", "Evalidation", "Bpre_processing", "Epre_processing",
+                                       "Brun",        "Bcompute",    "Ecompute",        "Erun",
+                                       "Bpost_processing", "Epost_processing"};
+  ASSERT_EQ(events.size(), expected.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    EXPECT_EQ(events[i].type + events[i].name, expected[i]);
+    EXPECT_EQ(events[i].pid, 3);
+    if (i > 0) {
+      EXPECT_GE(events[i].timestamp_us, events[i - 1].timestamp_us);
+    }
+  }
+  EXPECT_EQ(events[0].category, "phase");
+  EXPECT_EQ(events[5].category, "region");
+}
+
+TEST(trace_tests, check_disabled_tracer) {
+  auto& tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  TraceTestTask task(std::make_shared<ppc::core::TaskData>());
+  task.validation();
+  task.pre_processing();
+  task.run();
+  task.post_processing();
+  EXPECT_TRUE(tracer.events().empty());
+}
+
+TEST(trace_tests, check_threads_and_json) {
+  auto& tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable();
+  { ppc::core::TraceRegion region("main \"thread\""); }
+  std::thread([] { ppc::core::TraceRegion region("worker"); }).join();
+  tracer.disable();
+
+  auto events = tracer.events();
+  ASSERT_EQ(events.size(), 4U);
+  EXPECT_NE(events[0].tid, events[2].tid);
+
+  std::ostringstream out;
+  tracer.write(out);
+  tracer.clear();
+  auto trace = out.str();
+  EXPECT_EQ(trace.rfind(R"({"traceEvents":[)", 0), 0U);
+  EXPECT_NE(trace.find(R"("name":"main \"thread\"","cat":"region","ph":"B")"), std::string::npos);
+  EXPECT_NE(trace.find(R"("displayTimeUnit":"ms"})"), std::string::npos);
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::core {
+
+// Sink of begin/end events in Chrome Trace Event format, which is opened by
+// chrome://tracing and ui.perfetto.dev. Phases of every Task are recorded
+// automatically, user regions are added with TraceRegion. Events are tagged
+// with rank of the process (pid) and index of the thread (tid). Recording is
+// disabled by default and costs one atomic load then.
+class Tracer {
+ public:
+  struct Event {
+    std::string name;
+    std::string category;
+    // 'B' for begin and 'E' for end of the event
+    char type = 'B';
+    // microseconds since unix epoch
+    double timestamp_us = 0.0;
+    int pid = 0;
+    uint64_t tid = 0;
+  };
+
+  // Tracer of the process
+  static Tracer &instance();
+
+  // start recording, events are tagged with rank
+  void enable(int rank_ = 0);
+  void disable();
+  [[nodiscard]] bool enabled() const { return is_enabled.load(std::memory_order_relaxed); }
+
+  void begin(std::string_view name, std::string_view category = "region");
+  void end(std::string_view name, std::string_view category = "region");
+
+  [[nodiscard]] std::vector<Event> events() const;
+  void clear();
+
+  // write recorded events as comma-separated JSON objects, so events of
+  // several processes can be concatenated
+  void write_events(std::ostream &out) const;
+  // write complete trace: {"traceEvents":[...]}
+  void write(std::ostream &out) const;
+  // write complete trace made of events written by write_events()
+  static void write_trace(std::ostream &out, const std::vector<std::string> &events_chunks);
+
+  // index of the calling thread, starting from 0 in order of the first call
+  static uint64_t thread_index();
+
+ private:
+  Tracer() = default;
+  void add(std::string_view name, std::string_view category, char type);
+
+  std::atomic<bool> is_enabled{false};
+  int rank = 0;
+  mutable std::mutex mutex;
+  std::vector<Event> recorded_events;
+};
+
+// Region of code recorded by the tracer from construction till destruction:
+//   { ppc::core::TraceRegion region("scatter"); ... }
+class TraceRegion {
+ public:
+  explicit TraceRegion(std::string name_);
+  TraceRegion(const TraceRegion &) = delete;
+  TraceRegion &operator=(const TraceRegion &) = delete;
+  ~TraceRegion();
+
+ private:
+  std::string name;
+  bool is_recorded;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_HPP_
@@ -0,0 +1,107 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/trace/include/trace.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+std::string json_escape(std::string_view str) {
+  std::ostringstream result;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      result << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      result << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+    } else {
+      result << c;
+    }
+  }
+  return result.str();
+}
+
+}  // namespace
+
+ppc::core::Tracer &ppc::core::Tracer::instance() {
+  static Tracer tracer;
+  return tracer;
+}
+
+void ppc::core::Tracer::enable(int rank_) {
+  std::lock_guard lock(mutex);
+  rank = rank_;
+  is_enabled.store(true, std::memory_order_relaxed);
+}
+
+void ppc::core::Tracer::disable() { is_enabled.store(false, std::memory_order_relaxed); }
+
+void ppc::core::Tracer::begin(std::string_view name, std::string_view category) {
+  if (enabled()) add(name, category, 'B');
+}
+
+void ppc::core::Tracer::end(std::string_view name, std::string_view category) {
+  if (enabled()) add(name, category, 'E');
+}
+
+void ppc::core::Tracer::add(std::string_view name, std::string_view category, char type) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  auto timestamp_us = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()) * 1e-3;
+  auto tid = thread_index();
+  std::lock_guard lock(mutex);
+  recorded_events.push_back(Event{std::string(name), std::string(category), type, timestamp_us, rank, tid});
+}
+
+std::vector<ppc::core::Tracer::Event> ppc::core::Tracer::events() const {
+  std::lock_guard lock(mutex);
+  return recorded_events;
+}
+
+void ppc::core::Tracer::clear() {
+  std::lock_guard lock(mutex);
+  recorded_events.clear();
+}
+
+void ppc::core::Tracer::write_events(std::ostream &out) const {
+  std::lock_guard lock(mutex);
+  for (size_t i = 0; i < recorded_events.size(); i++) {
+    const auto &event = recorded_events[i];
+    out << (i == 0 ? "" : ",\n") << R"({"name":")" << json_escape(event.name) << R"(","cat":")"
+        << json_escape(event.category) << R"(","ph":")" << event.type << R"(","ts":)" << std::fixed
+        << std::setprecision(3) << event.timestamp_us << R"(,"pid":)" << event.pid << R"(,"tid":)" << event.tid
+        << "}";
+  }
+}
+
+void ppc::core::Tracer::write(std::ostream &out) const {
+  std::ostringstream events_chunk;
+  write_events(events_chunk);
+  write_trace(out, {events_chunk.str()});
+}
+
+void ppc::core::Tracer::write_trace(std::ostream &out, const std::vector<std::string> &events_chunks) {
+  out << R"({"traceEvents":[)" << std::endl;
+  bool is_first = true;
+  for (const auto &chunk : events_chunks) {
+    if (chunk.empty()) continue;
+    out << (is_first ? "" : ",\n") << chunk;
+    is_first = false;
+  }
+  out << std::endl << R"(],"displayTimeUnit":"ms"})" << std::endl;
+}
+
+uint64_t ppc::core::Tracer::thread_index() {
+  static std::atomic<uint64_t> threads_count{0};
+  thread_local uint64_t index = threads_count.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+ppc::core::TraceRegion::TraceRegion(std::string name_)
+    : name(std::move(name_)), is_recorded(Tracer::instance().enabled()) {
+  if (is_recorded) Tracer::instance().begin(name);
+}
+
+ppc::core::TraceRegion::~TraceRegion() {
+  if (is_recorded) Tracer::instance().end(name);
+}
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -20,12 +21,8 @@ class AverageOfVectorElements : public ppc::core::Task {
   explicit AverageOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InType>(0, input_storage_);
     // Init value for output
     average = 0.0;
     return true;
@@ -44,14 +41,19 @@ class AverageOfVectorElements : public ppc::core::Task {
     return true;
   }
 
+  // read of input and one addition per element
+  [[nodiscard]] uint64_t bytes_per_run() const override { return taskData->inputs_count[0] * sizeof(InType); }
+  [[nodiscard]] uint64_t ops_per_run() const override { return taskData->inputs_count[0]; }
+
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<OutType*>(taskData->outputs[0])[0] = average;
+    taskData->output_as<OutType>(0)[0] = average;
     return true;
   }
 
  private:
-  std::vector<InType> input_;
+  std::span<const InType> input_;
+  std::vector<InType> input_storage_;
   OutType average;
 };
 
@@ -8,9 +8,11 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/simd_reductions.hpp"
 
 namespace ppc {
 namespace reference {
@@ -21,12 +23,8 @@ class MaxOfVectorElements : public ppc::core::Task {
   explicit MaxOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     // Init value for output
     max = 0.0;
     max_index = 0;
@@ -46,21 +44,22 @@ class MaxOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::max_element(input_.begin(), input_.end());
-    max = static_cast<InOutType>(*result);
-    max_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    auto result = simd::argmax(input_);
+    max = result.value;
+    max_index = static_cast<IndexType>(result.index);
     return true;
   }
 
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = max;
-    reinterpret_cast<IndexType*>(taskData->outputs[1])[0] = max_index;
+    taskData->output_as<InOutType>(0)[0] = max;
+    taskData->output_as<IndexType>(1)[0] = max_index;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   InOutType max;
   IndexType max_index;
 };
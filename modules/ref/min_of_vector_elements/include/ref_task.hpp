@@ -8,9 +8,11 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/simd_reductions.hpp"
 
 namespace ppc {
 namespace reference {
@@ -21,12 +23,8 @@ class MinOfVectorElements : public ppc::core::Task {
   explicit MinOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     // Init value for output
     min = 0.0;
     min_index = 0;
@@ -46,21 +44,22 @@ class MinOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::min_element(input_.begin(), input_.end());
-    min = static_cast<InOutType>(*result);
-    min_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    auto result = simd::argmin(input_);
+    min = result.value;
+    min_index = static_cast<IndexType>(result.index);
     return true;
   }
 
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = min;
-    reinterpret_cast<IndexType*>(taskData->outputs[1])[0] = min_index;
+    taskData->output_as<InOutType>(0)[0] = min;
+    taskData->output_as<IndexType>(1)[0] = min_index;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   InOutType min;
   IndexType min_index;
 };
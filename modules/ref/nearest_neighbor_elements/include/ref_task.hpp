@@ -9,9 +9,11 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/adjacent_reductions.hpp"
 
 namespace ppc {
 namespace reference {
@@ -22,12 +24,8 @@ class NearestNeighborElements : public ppc::core::Task {
   explicit NearestNeighborElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     // Init value for output
     l_elem = r_elem = 0;
     l_elem_index = r_elem_index = 0;
@@ -42,16 +40,8 @@ class NearestNeighborElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<InOutType>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return std::abs(x - y); });
-
-    auto result = std::min_element(temp_res.begin(), temp_res.end() - 1);
-    l_elem_index = static_cast<IndexType>(std::distance(temp_res.begin(), result));
+    auto result = simd::adjacent_reduce(input_, simd::AbsDifference{}, simd::FirstMinPair{});
+    l_elem_index = static_cast<IndexType>(result.index);
     l_elem = input_[l_elem_index];
 
     r_elem_index = l_elem_index + 1;
@@ -61,15 +51,16 @@ class NearestNeighborElements : public ppc::core::Task {
 
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = l_elem;
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[1] = r_elem;
-    reinterpret_cast<IndexType*>(taskData->outputs[1])[0] = l_elem_index;
-    reinterpret_cast<IndexType*>(taskData->outputs[1])[1] = r_elem_index;
+    taskData->output_as<InOutType>(0)[0] = l_elem;
+    taskData->output_as<InOutType>(0)[1] = r_elem;
+    taskData->output_as<IndexType>(1)[0] = l_elem_index;
+    taskData->output_as<IndexType>(1)[1] = r_elem_index;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   InOutType l_elem, r_elem;
   IndexType l_elem_index, r_elem_index;
 };
@@ -9,9 +9,11 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/adjacent_reductions.hpp"
 
 namespace ppc {
 namespace reference {
@@ -22,12 +24,8 @@ class NumOfAlternationsSigns : public ppc::core::Task {
   explicit NumOfAlternationsSigns(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     // Init value for output
     num = 0;
     return true;
@@ -41,25 +39,19 @@ class NumOfAlternationsSigns : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = input_;
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(), std::multiplies<>());
-
-    num = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem < 0; });
+    num = static_cast<CountType>(simd::adjacent_reduce(input_, simd::OppositeSigns{}, simd::CountPairs{}));
     return true;
   }
 
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<CountType*>(taskData->outputs[0])[0] = num;
+    taskData->output_as<CountType>(0)[0] = num;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   CountType num;
 };
 
@@ -0,0 +1,174 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "ref/simd_reductions/include/adjacent_reductions.hpp"
+#include "ref/simd_reductions/include/simd_reductions.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> random_vector(size_t size, uint64_t seed) {
+  std::mt19937_64 generator(seed);
+  std::vector<T> values(size);
+  for (auto& value : values) value = static_cast<T>(static_cast<int64_t>(generator() % 2001) - 1000);
+  return values;
+}
+
+// Results of kernels of every level supported by CPU are compared with scalar
+// ones on sizes with and without tails
+template <class T>
+void check_kernels_of_all_levels() {
+  using ppc::reference::simd::Level;
+  auto detected_level = ppc::reference::simd::detected_level();
+  for (auto size : {0, 1, 7, 16, 33, 100, 1000, 4099}) {
+    auto lhs = random_vector<T>(size, size);
+    auto rhs = random_vector<T>(size, size + 1);
+    std::span<const T> lhs_view(lhs);
+    std::span<const T> rhs_view(rhs);
+    auto expected_sum = ppc::reference::simd::sum_scalar(lhs_view);
+    auto expected_dot = ppc::reference::simd::dot_scalar(lhs_view, rhs_view);
+    auto expected_min = ppc::reference::simd::arg_extremum_scalar<T, false>(lhs_view);
+    auto expected_max = ppc::reference::simd::arg_extremum_scalar<T, true>(lhs_view);
+    for (auto level : {Level::SCALAR, Level::SSE4_2, Level::AVX2, Level::AVX512}) {
+      if (level > detected_level) continue;
+      ppc::reference::simd::set_level(level);
+      SCOPED_TRACE(ppc::reference::simd::level_name(level) + ", size " + std::to_string(size));
+      EXPECT_EQ(ppc::reference::simd::sum(lhs_view), expected_sum);
+      EXPECT_EQ(ppc::reference::simd::dot(lhs_view, rhs_view), expected_dot);
+      auto min = ppc::reference::simd::argmin(lhs_view);
+      EXPECT_EQ(min.value, expected_min.value);
+      EXPECT_EQ(min.index, expected_min.index);
+      auto max = ppc::reference::simd::argmax(lhs_view);
+      EXPECT_EQ(max.value, expected_max.value);
+      EXPECT_EQ(max.index, expected_max.index);
+    }
+  }
+  ppc::reference::simd::set_level(detected_level);
+}
+
+// Adjacent reductions are compared with loops over pairs
+template <class T>
+void check_adjacent_reductions() {
+  for (auto size : {0, 1, 2, 5, 17, 100, 1001, 4099}) {
+    SCOPED_TRACE("size " + std::to_string(size));
+    auto values = random_vector<T>(size, size);
+    // equal extremums in different lanes
+    if (size > 50) values[40] = values[41] = values[45] = values[46] = 0;
+    std::span<const T> view(values);
+
+    uint64_t violations = 0;
+    uint64_t alternations = 0;
+    ppc::reference::simd::ArgResult<T> max;
+    ppc::reference::simd::ArgResult<T> min;
+    for (size_t i = 0; i + 1 < values.size(); i++) {
+      T x = values[i];
+      T y = values[i + 1];
+      violations += x > y ? 1 : 0;
+      alternations += (x < 0 && y > 0) || (x > 0 && y < 0) ? 1 : 0;
+      T difference = x > y ? x - y : y - x;
+      if (i == 0 || difference > max.value) max = {difference, i};
+      if (i == 0 || difference < min.value) min = {difference, i};
+    }
+
+    namespace simd = ppc::reference::simd;
+    EXPECT_EQ(simd::adjacent_reduce(view, simd::Greater{}, simd::CountPairs{}), violations);
+    EXPECT_EQ(simd::adjacent_reduce(view, simd::OppositeSigns{}, simd::CountPairs{}), alternations);
+    auto max_result = simd::adjacent_reduce(view, simd::AbsDifference{}, simd::FirstMaxPair{});
+    EXPECT_EQ(max_result.value, max.value);
+    EXPECT_EQ(max_result.index, max.index);
+    auto min_result = simd::adjacent_reduce(view, simd::AbsDifference{}, simd::FirstMinPair{});
+    EXPECT_EQ(min_result.value, min.value);
+    EXPECT_EQ(min_result.index, min.index);
+  }
+}
+
+}  // namespace
+
+TEST(simd_reductions, check_int32_t) { check_kernels_of_all_levels<int32_t>(); }
+
+TEST(simd_reductions, check_int64_t) { check_kernels_of_all_levels<int64_t>(); }
+
+TEST(simd_reductions, check_float) { check_kernels_of_all_levels<float>(); }
+
+TEST(simd_reductions, check_double) { check_kernels_of_all_levels<double>(); }
+
+TEST(simd_reductions, check_scalar_types) {
+  std::vector<uint8_t> values = {3, 200, 1, 200, 1};
+  std::span<const uint8_t> view(values);
+  EXPECT_EQ(ppc::reference::simd::sum(view), 405U);
+  EXPECT_EQ(ppc::reference::simd::argmin(view).index, 2U);
+  EXPECT_EQ(ppc::reference::simd::argmax(view).index, 1U);
+}
+
+TEST(simd_reductions, check_int32_t_sum_doesnt_overflow) {
+  std::vector<int32_t> values(1000, INT32_MAX);
+  EXPECT_EQ(ppc::reference::simd::sum(std::span<const int32_t>(values)), int64_t{INT32_MAX} * 1000);
+}
+
+TEST(simd_reductions, check_first_of_equal_extremums) {
+  std::vector<float> values(1000, 5.0f);
+  values[517] = values[901] = -1.0f;
+  values[3] = values[64] = 9.0f;
+  auto min = ppc::reference::simd::argmin(std::span<const float>(values));
+  auto max = ppc::reference::simd::argmax(std::span<const float>(values));
+  EXPECT_EQ(min.value, -1.0f);
+  EXPECT_EQ(min.index, 517U);
+  EXPECT_EQ(max.value, 9.0f);
+  EXPECT_EQ(max.index, 3U);
+}
+
+TEST(simd_reductions, check_nan_is_skipped) {
+  using ppc::reference::simd::Level;
+  auto detected_level = ppc::reference::simd::detected_level();
+  auto nan = std::numeric_limits<float>::quiet_NaN();
+  // NaN seeds every lane and the tail, extremums follow it
+  std::vector<float> values(1003, 5.0f);
+  for (size_t i = 0; i < 64; i++) values[i] = nan;
+  values[1001] = nan;
+  values[700] = -1.0f;
+  values[1002] = 9.0f;
+  std::vector<float> nans(100, nan);
+  for (auto level : {Level::SCALAR, Level::SSE4_2, Level::AVX2, Level::AVX512}) {
+    if (level > detected_level) continue;
+    ppc::reference::simd::set_level(level);
+    SCOPED_TRACE(ppc::reference::simd::level_name(level));
+    auto min = ppc::reference::simd::argmin(std::span<const float>(values));
+    auto max = ppc::reference::simd::argmax(std::span<const float>(values));
+    EXPECT_EQ(min.value, -1.0f);
+    EXPECT_EQ(min.index, 700U);
+    EXPECT_EQ(max.value, 9.0f);
+    EXPECT_EQ(max.index, 1002U);
+    auto max_of_five = ppc::reference::simd::argmax(std::span<const float>(values).subspan(60, 100));
+    EXPECT_EQ(max_of_five.value, 5.0f);
+    EXPECT_EQ(max_of_five.index, 4U);
+    // only NaN gives NaN with index 0
+    auto nan_min = ppc::reference::simd::argmin(std::span<const float>(nans));
+    EXPECT_TRUE(std::isnan(nan_min.value));
+    EXPECT_EQ(nan_min.index, 0U);
+  }
+  ppc::reference::simd::set_level(detected_level);
+}
+
+TEST(simd_reductions, check_level_limit) {
+  auto detected_level = ppc::reference::simd::detected_level();
+  EXPECT_EQ(ppc::reference::simd::active_level(), detected_level);
+  ppc::reference::simd::set_level(ppc::reference::simd::Level::SCALAR);
+  EXPECT_EQ(ppc::reference::simd::active_level(), ppc::reference::simd::Level::SCALAR);
+  ppc::reference::simd::set_level(ppc::reference::simd::Level::AVX512);
+  EXPECT_EQ(ppc::reference::simd::active_level(), detected_level);
+}
+
+TEST(simd_reductions, check_adjacent_reductions_int32_t) { check_adjacent_reductions<int32_t>(); }
+
+TEST(simd_reductions, check_adjacent_reductions_int64_t) { check_adjacent_reductions<int64_t>(); }
+
+TEST(simd_reductions, check_adjacent_reductions_float) { check_adjacent_reductions<float>(); }
+
+TEST(simd_reductions, check_adjacent_reductions_double) { check_adjacent_reductions<double>(); }
@@ -0,0 +1,186 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_REFERENCE_SIMD_REDUCTIONS_ADJACENT_REDUCTIONS_HPP_
+#define MODULES_REFERENCE_SIMD_REDUCTIONS_ADJACENT_REDUCTIONS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "ref/simd_reductions/include/simd_reductions.hpp"
+
+// Pair functors are called with vectors of 16 bytes, which are passed in
+// registers by default on these architectures. Wider vectors would need
+// functors compiled for the target of the kernel.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+#define PPC_SIMD_ADJACENT_VECTORS
+#endif
+
+// Single pass reduction of pairs of adjacent elements without temporary
+// buffers. Pair functor maps (values[i], values[i + 1]) to a value and
+// combiner reduces values of all pairs.
+namespace ppc::reference::simd {
+
+// Pair functors; they are applied both to elements and to vectors of elements,
+// so they use operators only
+
+// absolute difference of elements
+struct AbsDifference {
+  template <class X>
+  auto operator()(X x, X y) const {
+    return x > y ? x - y : y - x;
+  }
+};
+
+// the first element is greater than the second one
+struct Greater {
+  template <class X>
+  auto operator()(X x, X y) const {
+    return x > y;
+  }
+};
+
+// elements are non-zero and have different signs
+struct OppositeSigns {
+  template <class X>
+  auto operator()(X x, X y) const {
+    return ((x < X{}) & (y > X{})) | ((x > X{}) & (y < X{}));
+  }
+};
+
+// Combiner counting pairs with true value of a predicate pair functor
+struct CountPairs {
+  template <class Value>
+  using Result = uint64_t;
+
+  template <class Value>
+  static void combine(uint64_t &result, Value value, size_t /*index*/) {
+    if (value) result++;
+  }
+
+  // counts of lanes of vectors; values of vectors are masks with -1 in lanes
+  // of true values
+  template <class ValueVector, class IndexVector>
+  struct Lanes {
+    IndexVector counts;
+
+    Lanes(ValueVector value, IndexVector /*indexes*/) : counts(-__builtin_convertvector(value, IndexVector)) {}
+
+    void combine(ValueVector value, IndexVector /*indexes*/) { counts -= __builtin_convertvector(value, IndexVector); }
+
+    void merge(uint64_t &result) const {
+      for (size_t j = 0; j < sizeof(IndexVector) / sizeof(counts[0]); j++) result += static_cast<uint64_t>(counts[j]);
+    }
+  };
+};
+
+// Combiner finding the first pair with the largest or the least value
+template <bool is_max>
+struct FirstExtremumPair {
+  template <class Value>
+  using Result = ArgResult<Value>;
+
+  template <class Value>
+  static void combine(ArgResult<Value> &result, Value value, size_t index) {
+    if (index == 0 || (is_max ? value > result.value : value < result.value)) result = {value, index};
+  }
+
+  // extremums of lanes and indexes of their pairs
+  template <class ValueVector, class IndexVector>
+  struct Lanes {
+    ValueVector best;
+    IndexVector best_indexes;
+
+    Lanes(ValueVector value, IndexVector indexes) : best(value), best_indexes(indexes) {}
+
+    void combine(ValueVector value, IndexVector indexes) {
+      auto is_better = is_max ? value > best : value < best;
+      best = is_better ? value : best;
+      best_indexes = is_better ? indexes : best_indexes;
+    }
+
+    // the best lane with the least index among equal ones
+    template <class Value>
+    void merge(ArgResult<Value> &result) const {
+      for (size_t j = 0; j < sizeof(IndexVector) / sizeof(best_indexes[0]); j++) {
+        ArgResult<Value> lane{static_cast<Value>(best[j]), static_cast<size_t>(best_indexes[j])};
+        bool is_better = is_max ? lane.value > result.value : lane.value < result.value;
+        if (j == 0 || is_better || (lane.value == result.value && lane.index < result.index)) result = lane;
+      }
+    }
+  };
+};
+
+using FirstMaxPair = FirstExtremumPair<true>;
+using FirstMinPair = FirstExtremumPair<false>;
+
+namespace detail {
+
+#ifdef PPC_SIMD_ADJACENT_VECTORS
+
+template <class T, size_t lanes>
+struct VectorType {
+  typedef T type __attribute__((vector_size(lanes * sizeof(T))));
+};
+
+// Reduce pairs by vectors of lanes and merge lanes into result; returns count
+// of reduced pairs. Indexes have width of T, so count of pairs has to be less
+// than the largest index.
+template <class T, class Pair, class Combiner, class Result>
+size_t adjacent_reduce_lanes(std::span<const T> values, Pair pair, Result &result) {
+  constexpr size_t lanes = 16 / sizeof(T);
+  using Vector = typename VectorType<T, lanes>::type;
+  using Index = std::conditional_t<sizeof(T) == sizeof(int32_t), int32_t, int64_t>;
+  using IndexVector = typename VectorType<Index, lanes>::type;
+  const T *data = values.data();
+  size_t end = (values.size() - 1) / lanes * lanes;
+
+  Vector x;
+  Vector y;
+  std::memcpy(&x, data, sizeof(x));
+  std::memcpy(&y, data + 1, sizeof(y));
+  IndexVector indexes;
+  for (size_t j = 0; j < lanes; j++) indexes[j] = static_cast<Index>(j);
+  typename Combiner::template Lanes<decltype(pair(x, y)), IndexVector> state(pair(x, y), indexes);
+  for (size_t i = lanes; i < end; i += lanes) {
+    std::memcpy(&x, data + i, sizeof(x));
+    std::memcpy(&y, data + i + 1, sizeof(y));
+    indexes += static_cast<Index>(lanes);
+    state.combine(pair(x, y), indexes);
+  }
+  state.merge(result);
+  return end;
+}
+
+#endif
+
+}  // namespace detail
+
+// Reduce pairs (values[i], values[i + 1]) in order of i; result is value
+// initialized if there are no pairs
+template <class T, class Pair, class Combiner>
+auto adjacent_reduce(std::span<const T> values, Pair pair, Combiner /*combiner*/) {
+  using Value = decltype(pair(values[0], values[0]));
+  typename Combiner::template Result<Value> result{};
+  if (values.size() < 2) return result;
+
+  size_t i = 0;
+#ifdef PPC_SIMD_ADJACENT_VECTORS
+  if constexpr (detail::has_kernels<T>) {
+    constexpr size_t max_pairs_count = size_t{1} << (8 * sizeof(T) - 2);
+    if (values.size() > 16 / sizeof(T) && values.size() <= max_pairs_count) {
+      i = detail::adjacent_reduce_lanes<T, Pair, Combiner>(values, pair, result);
+    }
+  }
+#endif
+  for (; i + 1 < values.size(); i++) {
+    Combiner::combine(result, pair(values[i], values[i + 1]), i);
+  }
+  return result;
+}
+
+}  // namespace ppc::reference::simd
+
+#endif  // MODULES_REFERENCE_SIMD_REDUCTIONS_ADJACENT_REDUCTIONS_HPP_
@@ -0,0 +1,138 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_REFERENCE_SIMD_REDUCTIONS_SIMD_REDUCTIONS_HPP_
+#define MODULES_REFERENCE_SIMD_REDUCTIONS_SIMD_REDUCTIONS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+// Reductions of vectors with explicitly vectorized kernels for int32_t,
+// int64_t, float and double. Kernel for SSE4.2, AVX2 or AVX-512 is chosen at
+// runtime by features of CPU; other types, other architectures and compilers
+// without vector extensions use scalar kernels.
+namespace ppc::reference::simd {
+
+enum class Level : uint8_t { SCALAR, SSE4_2, AVX2, AVX512 };
+
+// the widest level supported by CPU and compiler
+Level detected_level();
+
+// level used by kernels, the detected one by default
+Level active_level();
+
+// limit level used by kernels, e.g. to compare kernels; it can't exceed the
+// detected one
+void set_level(Level level);
+
+std::string level_name(Level level);
+
+// type of sums: 64-bit integers for integers and double for floating point
+// values, so sums of int32_t and float don't overflow or lose precision
+template <class T>
+using Accumulator =
+    std::conditional_t<std::is_floating_point_v<T>, double, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+template <class T>
+struct ArgResult {
+  T value{};
+  // index of the first element equal to value
+  size_t index = 0;
+};
+
+template <class T>
+Accumulator<T> sum_scalar(std::span<const T> values) {
+  Accumulator<T> result = 0;
+  for (auto value : values) result += static_cast<Accumulator<T>>(value);
+  return result;
+}
+
+template <class T>
+Accumulator<T> dot_scalar(std::span<const T> lhs, std::span<const T> rhs) {
+  Accumulator<T> result = 0;
+  for (size_t i = 0; i < lhs.size(); i++) result += static_cast<Accumulator<T>>(lhs[i]) * rhs[i];
+  return result;
+}
+
+// NaN is the only value which isn't equal to itself
+template <class T>
+constexpr bool is_nan(T value) {
+  return value != value;
+}
+
+// the first minimum or maximum, value-initialized result for empty values.
+// NaN elements are skipped: the result is NaN with index 0 only if all values
+// are NaN.
+template <class T, bool is_max>
+ArgResult<T> arg_extremum_scalar(std::span<const T> values) {
+  ArgResult<T> result;
+  for (size_t i = 0; i < values.size(); i++) {
+    bool is_better = is_max ? values[i] > result.value : values[i] < result.value;
+    if (i == 0 || is_better || (is_nan(result.value) && !is_nan(values[i]))) result = {values[i], i};
+  }
+  return result;
+}
+
+namespace detail {
+
+template <class T>
+constexpr bool has_kernels = std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+                             std::is_same_v<T, double>;
+
+#define PPC_SIMD_DECLARE_KERNELS(T)                                              \
+  Accumulator<T> sum(std::span<const T> values);                                 \
+  Accumulator<T> dot(std::span<const T> lhs, std::span<const T> rhs);            \
+  ArgResult<T> argmin(std::span<const T> values);                                \
+  ArgResult<T> argmax(std::span<const T> values);
+
+PPC_SIMD_DECLARE_KERNELS(int32_t)
+PPC_SIMD_DECLARE_KERNELS(int64_t)
+PPC_SIMD_DECLARE_KERNELS(float)
+PPC_SIMD_DECLARE_KERNELS(double)
+
+#undef PPC_SIMD_DECLARE_KERNELS
+
+}  // namespace detail
+
+template <class T>
+Accumulator<T> sum(std::span<const T> values) {
+  if constexpr (detail::has_kernels<T>) {
+    return detail::sum(values);
+  } else {
+    return sum_scalar(values);
+  }
+}
+
+// dot product of vectors of the same size
+template <class T>
+Accumulator<T> dot(std::span<const T> lhs, std::span<const T> rhs) {
+  if constexpr (detail::has_kernels<T>) {
+    return detail::dot(lhs, rhs);
+  } else {
+    return dot_scalar(lhs, rhs);
+  }
+}
+
+template <class T>
+ArgResult<T> argmin(std::span<const T> values) {
+  if constexpr (detail::has_kernels<T>) {
+    return detail::argmin(values);
+  } else {
+    return arg_extremum_scalar<T, false>(values);
+  }
+}
+
+template <class T>
+ArgResult<T> argmax(std::span<const T> values) {
+  if constexpr (detail::has_kernels<T>) {
+    return detail::argmax(values);
+  } else {
+    return arg_extremum_scalar<T, true>(values);
+  }
+}
+
+}  // namespace ppc::reference::simd
+
+#endif  // MODULES_REFERENCE_SIMD_REDUCTIONS_SIMD_REDUCTIONS_HPP_
@@ -0,0 +1,130 @@
+// Copyright 2024 Nesterov Alexander
+#include "ref/simd_reductions/include/simd_reductions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PPC_SIMD_X86
+#endif
+
+namespace ppc::reference::simd {
+namespace {
+
+#ifdef PPC_SIMD_X86
+
+#define PPC_SIMD_NAMESPACE sse4_2
+#define PPC_SIMD_TARGET __attribute__((target("sse4.2")))
+#define PPC_SIMD_BYTES 16
+#include "ref/simd_reductions/src/simd_kernels.inc"
+#undef PPC_SIMD_NAMESPACE
+#undef PPC_SIMD_TARGET
+#undef PPC_SIMD_BYTES
+
+#define PPC_SIMD_NAMESPACE avx2
+#define PPC_SIMD_TARGET __attribute__((target("avx2")))
+#define PPC_SIMD_BYTES 32
+#include "ref/simd_reductions/src/simd_kernels.inc"
+#undef PPC_SIMD_NAMESPACE
+#undef PPC_SIMD_TARGET
+#undef PPC_SIMD_BYTES
+
+#define PPC_SIMD_NAMESPACE avx512
+#define PPC_SIMD_TARGET __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw")))
+#define PPC_SIMD_BYTES 64
+#include "ref/simd_reductions/src/simd_kernels.inc"
+#undef PPC_SIMD_NAMESPACE
+#undef PPC_SIMD_TARGET
+#undef PPC_SIMD_BYTES
+
+#endif
+
+template <class T>
+struct Kernels {
+  Accumulator<T> (*sum)(std::span<const T>);
+  Accumulator<T> (*dot)(std::span<const T>, std::span<const T>);
+  ArgResult<T> (*argmin)(std::span<const T>);
+  ArgResult<T> (*argmax)(std::span<const T>);
+};
+
+template <class T>
+Kernels<T> kernels() {
+  switch (active_level()) {
+#ifdef PPC_SIMD_X86
+    case Level::AVX512:
+      return {avx512::sum<T>, avx512::dot<T>, avx512::arg_extremum<T, false>, avx512::arg_extremum<T, true>};
+    case Level::AVX2:
+      return {avx2::sum<T>, avx2::dot<T>, avx2::arg_extremum<T, false>, avx2::arg_extremum<T, true>};
+    case Level::SSE4_2:
+      return {sse4_2::sum<T>, sse4_2::dot<T>, sse4_2::arg_extremum<T, false>, sse4_2::arg_extremum<T, true>};
+#endif
+    default:
+      return {sum_scalar<T>, dot_scalar<T>, arg_extremum_scalar<T, false>, arg_extremum_scalar<T, true>};
+  }
+}
+
+std::atomic<Level>& level_limit() {
+  static std::atomic<Level> level{detected_level()};
+  return level;
+}
+
+}  // namespace
+}  // namespace ppc::reference::simd
+
+ppc::reference::simd::Level ppc::reference::simd::detected_level() {
+#ifdef PPC_SIMD_X86
+  // Features are checked together with support of their registers by OS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512bw")) {
+    return Level::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+  if (__builtin_cpu_supports("sse4.2")) return Level::SSE4_2;
+#endif
+  return Level::SCALAR;
+}
+
+ppc::reference::simd::Level ppc::reference::simd::active_level() {
+  return level_limit().load(std::memory_order_relaxed);
+}
+
+void ppc::reference::simd::set_level(Level level) {
+  level_limit().store(std::min(level, detected_level()), std::memory_order_relaxed);
+}
+
+std::string ppc::reference::simd::level_name(Level level) {
+  switch (level) {
+    case Level::SSE4_2:
+      return "sse4.2";
+    case Level::AVX2:
+      return "avx2";
+    case Level::AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+#define PPC_SIMD_DEFINE_KERNELS(T)                                                                     \
+  ppc::reference::simd::Accumulator<T> ppc::reference::simd::detail::sum(std::span<const T> values) {  \
+    return kernels<T>().sum(values);                                                                   \
+  }                                                                                                    \
+  ppc::reference::simd::Accumulator<T> ppc::reference::simd::detail::dot(std::span<const T> lhs,       \
+                                                                         std::span<const T> rhs) {     \
+    return kernels<T>().dot(lhs, rhs);                                                                 \
+  }                                                                                                    \
+  ppc::reference::simd::ArgResult<T> ppc::reference::simd::detail::argmin(std::span<const T> values) { \
+    return kernels<T>().argmin(values);                                                                \
+  }                                                                                                    \
+  ppc::reference::simd::ArgResult<T> ppc::reference::simd::detail::argmax(std::span<const T> values) { \
+    return kernels<T>().argmax(values);                                                                \
+  }
+
+PPC_SIMD_DEFINE_KERNELS(int32_t)
+PPC_SIMD_DEFINE_KERNELS(int64_t)
+PPC_SIMD_DEFINE_KERNELS(float)
+PPC_SIMD_DEFINE_KERNELS(double)
+
+#undef PPC_SIMD_DEFINE_KERNELS
@@ -6,9 +6,11 @@
 
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/simd_reductions.hpp"
 
 namespace ppc::reference {
 
@@ -18,12 +20,8 @@ class SumOfVectorElements : public ppc::core::Task {
   explicit SumOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     // Init value for output
     sum = 0;
     return true;
@@ -37,18 +35,23 @@ class SumOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    sum = std::accumulate(input_.begin(), input_.end(), 0);
+    sum = static_cast<InOutType>(simd::sum(input_));
     return true;
   }
 
+  // read of input and one addition per element
+  [[nodiscard]] uint64_t bytes_per_run() const override { return taskData->inputs_count[0] * sizeof(InOutType); }
+  [[nodiscard]] uint64_t ops_per_run() const override { return taskData->inputs_count[0]; }
+
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = sum;
+    taskData->output_as<InOutType>(0)[0] = sum;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   InOutType sum;
 };
 
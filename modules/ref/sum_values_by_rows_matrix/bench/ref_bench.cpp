@@ -0,0 +1,24 @@
+// Copyright 2024 Nesterov Alexander
+#include <cmath>
+#include <memory>
+#include <type_traits>
+
+#include "core/perf/include/bench.hpp"
+#include "ref/sum_values_by_rows_matrix/include/ref_task.hpp"
+
+namespace {
+
+[[maybe_unused]] const bool registered = ppc::core::Bench::add_for_types<int32_t, int64_t, float, double>(
+    "sum_values_by_rows_matrix",
+    [](auto type, ppc::core::BenchData& data, uint64_t size) -> std::shared_ptr<ppc::core::Task> {
+      using T = typename decltype(type)::type;
+      // square matrix of about size elements
+      auto rows = static_cast<uint64_t>(std::sqrt(static_cast<double>(size)));
+      ppc::core::BenchData::fill_random<T>(data.add_input<T>(rows * rows), -100, 100);
+      auto shape = data.add_input<uint64_t>(2);
+      shape[0] = shape[1] = rows;
+      data.add_output<T>(rows);
+      return std::make_shared<ppc::reference::SumValuesByRowsMatrix<T, uint64_t>>(data.task_data());
+    });
+
+}  // namespace
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -20,12 +21,8 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   explicit SumValuesByRowsMatrix(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input
+    input_ = taskData->input_view<InOutType>(0, input_storage_);
     rows = reinterpret_cast<IndexType*>(taskData->inputs[1])[0];
     cols = reinterpret_cast<IndexType*>(taskData->inputs[1])[1];
 
@@ -49,16 +46,22 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
     return true;
   }
 
+  // read of matrix and one addition per element
+  [[nodiscard]] uint64_t bytes_per_run() const override { return taskData->inputs_count[0] * sizeof(InOutType); }
+  [[nodiscard]] uint64_t ops_per_run() const override { return taskData->inputs_count[0]; }
+
   bool post_processing() override {
     internal_order_test();
+    auto output = taskData->output_as<InOutType>(0);
     for (IndexType i = 0; i < rows; i++) {
-      reinterpret_cast<InOutType*>(taskData->outputs[0])[i] = sum_[i];
+      output[i] = sum_[i];
     }
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
+  std::vector<InOutType> input_storage_;
   IndexType rows, cols;
   std::vector<InOutType> sum_;
 };
@@ -0,0 +1,19 @@
+// Copyright 2024 Nesterov Alexander
+#include <memory>
+#include <type_traits>
+
+#include "core/perf/include/bench.hpp"
+#include "ref/vector_dot_product/include/ref_task.hpp"
+
+namespace {
+
+[[maybe_unused]] const bool registered = ppc::core::Bench::add_for_types<int32_t, int64_t, float, double>(
+    "vector_dot_product", [](auto type, ppc::core::BenchData& data, uint64_t size) -> std::shared_ptr<ppc::core::Task> {
+      using T = typename decltype(type)::type;
+      ppc::core::BenchData::fill_random<T>(data.add_input<T>(size), -100, 100);
+      ppc::core::BenchData::fill_random<T>(data.add_input<T>(size), -100, 100, 43);
+      data.add_output<T>(1);
+      return std::make_shared<ppc::reference::VectorDotProduct<T>>(data.task_data());
+    });
+
+}  // namespace
@@ -185,3 +185,24 @@ TEST(vector_dot_product, check_float) {
   testTask.post_processing();
   EXPECT_NEAR(out[0], in1.size() * (-1.3f) * 1.2f, 1e-3f);
 }
+
+TEST(vector_dot_product, check_bytes_and_ops_per_run) {
+  // Create data
+  std::vector<double> in1(100, 1.0);
+  std::vector<double> in2(100, 1.0);
+  std::vector<double> out(1, 0.0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in1.data()));
+  taskData->inputs_count.emplace_back(in1.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in2.data()));
+  taskData->inputs_count.emplace_back(in2.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::VectorDotProduct<double> testTask(taskData);
+  ASSERT_EQ(testTask.bytes_per_run(), 2 * 100 * sizeof(double));
+  ASSERT_EQ(testTask.ops_per_run(), 2U * 100);
+}
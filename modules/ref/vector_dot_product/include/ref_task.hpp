@@ -5,11 +5,14 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/simd_reductions/include/simd_reductions.hpp"
 
 namespace ppc {
 namespace reference {
@@ -20,14 +23,9 @@ class VectorDotProduct : public ppc::core::Task {
   explicit VectorDotProduct(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<std::vector<InOutType> >(2);
+    // Init views of inputs
     for (size_t i = 0; i < input_.size(); i++) {
-      input_[i] = std::vector<InOutType>(taskData->inputs_count[i]);
-      auto tmp_ptr_ = reinterpret_cast<InOutType*>(taskData->inputs[i]);
-      for (unsigned j = 0; j < taskData->inputs_count[i]; j++) {
-        input_[i][j] = tmp_ptr_[j];
-      }
+      input_[i] = taskData->input_view<InOutType>(i, input_storage_[i]);
     }
 
     // Init value for output
@@ -43,18 +41,23 @@ class VectorDotProduct : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    dor_product = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    dor_product = static_cast<InOutType>(simd::dot(input_[0], input_[1]));
     return true;
   }
 
+  // read of both inputs, multiplication and addition per pair of elements
+  [[nodiscard]] uint64_t bytes_per_run() const override { return 2 * taskData->inputs_count[0] * sizeof(InOutType); }
+  [[nodiscard]] uint64_t ops_per_run() const override { return 2 * taskData->inputs_count[0]; }
+
   bool post_processing() override {
     internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = dor_product;
+    taskData->output_as<InOutType>(0)[0] = dor_product;
     return true;
   }
 
  private:
-  std::vector<std::vector<InOutType> > input_;
+  std::array<std::span<const InOutType>, 2> input_;
+  std::array<std::vector<InOutType>, 2> input_storage_;
   InOutType dor_product;
 };
 
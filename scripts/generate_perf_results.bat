@@ -1,4 +1,6 @@
 @echo off
 mkdir build\perf_stat_dir
+set PPC_PERF_OUTPUT=build\perf_stat_dir\perf_results.jsonl
+if not defined PPC_PERF_BASELINE set PPC_PERF_BASELINE=build\perf_baseline.tsv
 scripts\run_perf_collector.bat > build\perf_stat_dir\perf_log.txt
 python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
@@ -1,3 +1,5 @@
 mkdir build/perf_stat_dir
+export PPC_PERF_OUTPUT=build/perf_stat_dir/perf_results.jsonl
+export PPC_PERF_BASELINE=${PPC_PERF_BASELINE:-build/perf_baseline.tsv}
 source scripts/run_perf_collector.sh 2>&1 | tee build/perf_stat_dir/perf_log.txt
 python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
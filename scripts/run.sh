@@ -12,6 +12,7 @@ if [[ $OSTYPE == "linux-gnu" && -z "$ASAN_RUN" ]]; then
 fi
 
 ./build/bin/core_func_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
+./build/bin/core_alloc_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
 ./build/bin/ref_func_tests  --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
 
 if [[ -z "$ASAN_RUN" ]]; then
@@ -7,6 +7,7 @@
 #include <boost/mpi/communicator.hpp>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,15 +28,17 @@ class TestMPITaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<const int> input_;
+  std::vector<int> input_storage_;
   int res{};
   std::string ops;
 };
 
 class TestMPITaskParallel : public ppc::core::Task {
  public:
-  explicit TestMPITaskParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
-      : Task(std::move(taskData_)), ops(std::move(ops_)) {}
+  explicit TestMPITaskParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_,
+                               boost::mpi::communicator world_ = {})
+      : Task(std::move(taskData_)), ops(std::move(ops_)), world(std::move(world_)) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
@@ -1,26 +1,38 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <boost/mpi/operations.hpp>
 #include <boost/mpi/timer.hpp>
+#include <cstdlib>
+#include <span>
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+#include "core/perf/include/perf_sweep.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
+namespace {
+
+// buffers released by a test are reused by the next ones
+ppc::core::BufferArena arena;
+
+}  // namespace
+
 TEST(mpi_example_perf_test, test_pipeline_run) {
   boost::mpi::communicator world;
-  std::vector<int> global_vec;
-  std::vector<int32_t> global_sum(1, 0);
-  // Create TaskData
+  std::span<int32_t> global_sum;
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
     count_size_vector = 120;
-    global_vec = std::vector<int>(count_size_vector, 1);
-    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
-    taskDataPar->inputs_count.emplace_back(global_vec.size());
-    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
-    taskDataPar->outputs_count.emplace_back(global_sum.size());
+    auto global_vec = arena.add_input<int>(*taskDataPar, count_size_vector);
+    std::fill(global_vec.begin(), global_vec.end(), 1);
+    global_sum = arena.add_output<int32_t>(*taskDataPar, 1);
+    global_sum[0] = 0;
   }
 
   auto testMpiTaskParallel = std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(taskDataPar, "+");
@@ -29,9 +41,12 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   testMpiTaskParallel->run();
   testMpiTaskParallel->post_processing();
 
-  // Create Perf attributes
+  // Create Perf attributes, count of runs is calibrated to 0.1 s on all processes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
+  perfAttr->target_time_sec = 0.1;
+  perfAttr->reduce_count = [&](uint64_t count) {
+    return boost::mpi::all_reduce(world, count, boost::mpi::maximum<uint64_t>());
+  };
   const boost::mpi::timer current_timer;
   perfAttr->current_timer = [&] { return current_timer.elapsed(); };
 
@@ -41,26 +56,29 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   // Create Perf analyzer
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
   perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  ppc::core::MpiPerfResults mpiPerfResults;
+  ppc::core::reduce_perf_results(world, *perfResults, mpiPerfResults);
   if (world.rank() == 0) {
     ppc::core::Perf::print_perf_statistic(perfResults);
+    ppc::core::print_mpi_perf_statistic(mpiPerfResults);
+    ppc::core::Perf::print_comm_statistic(perfResults);
     ASSERT_EQ(count_size_vector, global_sum[0]);
   }
+  arena.release(*taskDataPar);
 }
 
 TEST(mpi_example_perf_test, test_task_run) {
   boost::mpi::communicator world;
-  std::vector<int> global_vec;
-  std::vector<int32_t> global_sum(1, 0);
-  // Create TaskData
+  std::span<int32_t> global_sum;
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
     count_size_vector = 120;
-    global_vec = std::vector<int>(count_size_vector, 1);
-    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
-    taskDataPar->inputs_count.emplace_back(global_vec.size());
-    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
-    taskDataPar->outputs_count.emplace_back(global_sum.size());
+    auto global_vec = arena.add_input<int>(*taskDataPar, count_size_vector);
+    std::fill(global_vec.begin(), global_vec.end(), 1);
+    global_sum = arena.add_output<int32_t>(*taskDataPar, 1);
+    global_sum[0] = 0;
   }
 
   auto testMpiTaskParallel = std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(taskDataPar, "+");
@@ -69,9 +87,12 @@ TEST(mpi_example_perf_test, test_task_run) {
   testMpiTaskParallel->run();
   testMpiTaskParallel->post_processing();
 
-  // Create Perf attributes
+  // Create Perf attributes, count of runs is calibrated to 0.1 s on all processes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
+  perfAttr->target_time_sec = 0.1;
+  perfAttr->reduce_count = [&](uint64_t count) {
+    return boost::mpi::all_reduce(world, count, boost::mpi::maximum<uint64_t>());
+  };
   const boost::mpi::timer current_timer;
   perfAttr->current_timer = [&] { return current_timer.elapsed(); };
 
@@ -81,10 +102,68 @@ TEST(mpi_example_perf_test, test_task_run) {
   // Create Perf analyzer
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
   perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::MpiPerfResults mpiPerfResults;
+  ppc::core::reduce_perf_results(world, *perfResults, mpiPerfResults);
   if (world.rank() == 0) {
     ppc::core::Perf::print_perf_statistic(perfResults);
+    ppc::core::print_mpi_perf_statistic(mpiPerfResults);
+    ppc::core::Perf::print_comm_statistic(perfResults);
     ASSERT_EQ(count_size_vector, global_sum[0]);
   }
+  arena.release(*taskDataPar);
+}
+
+TEST(mpi_example_perf_test, test_scaling_sweep) {
+  boost::mpi::communicator world;
+  // Buffers of a measured point are reused by the next one
+  ppc::core::BufferArena sweepArena;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar;
+  std::vector<int32_t> global_sums;
+  auto release_point = [&] {
+    if (!taskDataPar || taskDataPar->outputs.empty()) return;
+    global_sums.push_back(reinterpret_cast<int32_t*>(taskDataPar->outputs[0])[0]);
+    sweepArena.release(*taskDataPar);
+  };
+
+  ppc::core::PerfSweep perfSweep([&](uint64_t size, uint64_t num_workers) -> std::shared_ptr<ppc::core::Task> {
+    // Run on sub-communicator of first num_workers processes
+    auto comm = world.split(world.rank() < static_cast<int>(num_workers) ? 0 : MPI_UNDEFINED);
+    release_point();
+    if (!comm) return nullptr;
+    taskDataPar = std::make_shared<ppc::core::TaskData>();
+    if (comm.rank() == 0) {
+      auto global_vec = sweepArena.add_input<int>(*taskDataPar, static_cast<uint32_t>(size));
+      std::fill(global_vec.begin(), global_vec.end(), 1);
+      sweepArena.add_output<int32_t>(*taskDataPar, 1)[0] = 0;
+    }
+    return std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(taskDataPar, "+", comm);
+  });
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  ppc::core::SweepAttr sweepAttr;
+  sweepAttr.workers.clear();
+  for (int num_workers = 1; num_workers <= world.size(); num_workers *= 2) {
+    sweepAttr.workers.push_back(num_workers);
+  }
+  sweepAttr.strong_size = 120000;
+  sweepAttr.weak_size_per_worker = 30000;
+
+  ppc::core::SweepResults sweepResults;
+  perfSweep.run(perfAttr, sweepAttr, sweepResults);
+  release_point();
+  if (world.rank() == 0) {
+    ppc::core::PerfSweep::print_sweep_statistic(sweepResults);
+    for (size_t i = 0; i < sweepResults.strong.size(); i++) {
+      ASSERT_EQ(global_sums[i], static_cast<int32_t>(sweepAttr.strong_size));
+    }
+    // every point fits into buffers of the first one
+    EXPECT_EQ(sweepArena.allocations_count(), 2U);
+  }
 }
 
 int main(int argc, char** argv) {
@@ -95,5 +174,10 @@ int main(int argc, char** argv) {
   if (world.rank() != 0) {
     delete listeners.Release(listeners.default_result_printer());
   }
-  return RUN_ALL_TESTS();
+  // Timeline of all processes is written to PPC_TRACE_OUTPUT if it is set
+  const char* trace_path = std::getenv("PPC_TRACE_OUTPUT");
+  if (trace_path != nullptr) ppc::core::Tracer::instance().enable(world.rank());
+  auto result = RUN_ALL_TESTS();
+  if (trace_path != nullptr) ppc::core::write_mpi_trace(world, trace_path);
+  return result;
 }
@@ -8,6 +8,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/trace/include/trace.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz) {
@@ -22,12 +24,8 @@ std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz) {
 
 bool nesterov_a_test_task_mpi::TestMPITaskSequential::pre_processing() {
   internal_order_test();
-  // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  // Init view of input
+  input_ = taskData->input_view<int>(0, input_storage_);
   // Init value for output
   res = 0;
   return true;
@@ -99,14 +97,18 @@ bool nesterov_a_test_task_mpi::TestMPITaskParallel::validation() {
 bool nesterov_a_test_task_mpi::TestMPITaskParallel::run() {
   internal_order_test();
   int local_res;
-  if (ops == "+") {
-    local_res = std::accumulate(local_input_.begin(), local_input_.end(), 0);
-  } else if (ops == "-") {
-    local_res = -std::accumulate(local_input_.begin(), local_input_.end(), 0);
-  } else if (ops == "max") {
-    local_res = *std::max_element(local_input_.begin(), local_input_.end());
+  {
+    ppc::core::TraceRegion region("compute");
+    if (ops == "+") {
+      local_res = std::accumulate(local_input_.begin(), local_input_.end(), 0);
+    } else if (ops == "-") {
+      local_res = -std::accumulate(local_input_.begin(), local_input_.end(), 0);
+    } else if (ops == "max") {
+      local_res = *std::max_element(local_input_.begin(), local_input_.end());
+    }
   }
 
+  ppc::core::TraceRegion region("reduce");
   if (ops == "+" || ops == "-") {
     reduce(world, local_res, res, std::plus(), 0);
   } else if (ops == "max") {
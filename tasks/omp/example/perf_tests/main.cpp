@@ -2,24 +2,31 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <algorithm>
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
+#include "core/perf/include/affinity_omp.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_sweep.hpp"
 #include "omp/example/include/ops_omp.hpp"
 
+namespace {
+
+// buffers released by a test are reused by the next ones
+ppc::core::BufferArena arena;
+
+}  // namespace
+
 TEST(openmp_example_perf_test, test_pipeline_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskOMP = std::make_shared<nesterov_a_test_task_omp::TestOMPTaskSequential>(taskDataSeq, "+");
@@ -28,6 +35,9 @@ TEST(openmp_example_perf_test, test_pipeline_run) {
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
   perfAttr->num_running = 10;
   perfAttr->current_timer = [&] { return omp_get_wtime(); };
+  perfAttr->affinity = ppc::core::AffinityPolicy::COMPACT;
+  perfAttr->pin_workers = ppc::core::pin_omp_threads;
+  perfAttr->num_workers = omp_get_max_threads();
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -37,21 +47,18 @@ TEST(openmp_example_perf_test, test_pipeline_run) {
   perfAnalyzer->pipeline_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count + 1, out[0]);
+  arena.release(*taskDataSeq);
 }
 
 TEST(openmp_example_perf_test, test_task_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskOMP = std::make_shared<nesterov_a_test_task_omp::TestOMPTaskSequential>(taskDataSeq, "+");
@@ -60,6 +67,9 @@ TEST(openmp_example_perf_test, test_task_run) {
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
   perfAttr->num_running = 10;
   perfAttr->current_timer = [&] { return omp_get_wtime(); };
+  perfAttr->affinity = ppc::core::AffinityPolicy::COMPACT;
+  perfAttr->pin_workers = ppc::core::pin_omp_threads;
+  perfAttr->num_workers = omp_get_max_threads();
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -69,6 +79,51 @@ TEST(openmp_example_perf_test, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count + 1, out[0]);
+  arena.release(*taskDataSeq);
+}
+
+TEST(openmp_example_perf_test, test_scaling_sweep) {
+  const int max_threads = omp_get_max_threads();
+  // Buffers of a measured point are reused by the next one
+  ppc::core::BufferArena sweepArena;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar;
+  std::vector<int> sums;
+  auto release_point = [&] {
+    sums.push_back(reinterpret_cast<int *>(taskDataPar->outputs[0])[0]);
+    sweepArena.release(*taskDataPar);
+  };
+
+  ppc::core::PerfSweep perfSweep([&](uint64_t size, uint64_t num_workers) -> std::shared_ptr<ppc::core::Task> {
+    // Next parallel regions use num_workers threads
+    omp_set_num_threads(static_cast<int>(num_workers));
+    if (taskDataPar) release_point();
+    taskDataPar = std::make_shared<ppc::core::TaskData>();
+    auto in = sweepArena.add_input<int>(*taskDataPar, static_cast<uint32_t>(size));
+    std::fill(in.begin(), in.end(), 1);
+    sweepArena.add_output<int>(*taskDataPar, 1)[0] = 0;
+    return std::make_shared<nesterov_a_test_task_omp::TestOMPTaskParallel>(taskDataPar, "+");
+  });
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->current_timer = [&] { return omp_get_wtime(); };
+
+  ppc::core::SweepAttr sweepAttr;
+  sweepAttr.workers = {1, 2, 4};
+  sweepAttr.strong_size = 120000;
+  sweepAttr.weak_size_per_worker = 30000;
+
+  ppc::core::SweepResults sweepResults;
+  perfSweep.run(perfAttr, sweepAttr, sweepResults);
+  release_point();
+  omp_set_num_threads(max_threads);
+  ppc::core::PerfSweep::print_sweep_statistic(sweepResults);
+  for (size_t i = 0; i < sweepResults.strong.size(); i++) {
+    ASSERT_EQ(sums[i], static_cast<int>(sweepAttr.strong_size) + 1);
+  }
+  // every point fits into buffers of the first one
+  EXPECT_EQ(sweepArena.allocations_count(), 2U);
 }
 
 int main(int argc, char **argv) {
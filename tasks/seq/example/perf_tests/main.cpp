@@ -3,22 +3,26 @@
 
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
 #include "core/perf/include/perf.hpp"
 #include "seq/example/include/ops_seq.hpp"
 
+namespace {
+
+// buffers released by a test are reused by the next ones
+ppc::core::BufferArena arena;
+
+}  // namespace
+
 TEST(sequential_example_perf_test, test_pipeline_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskSequential = std::make_shared<nesterov_a_test_task_seq::TestTaskSequential>(taskDataSeq);
@@ -41,21 +45,18 @@ TEST(sequential_example_perf_test, test_pipeline_run) {
   perfAnalyzer->pipeline_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count, out[0]);
+  arena.release(*taskDataSeq);
 }
 
 TEST(sequential_example_perf_test, test_task_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskSequential = std::make_shared<nesterov_a_test_task_seq::TestTaskSequential>(taskDataSeq);
@@ -78,6 +79,7 @@ TEST(sequential_example_perf_test, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count, out[0]);
+  arena.release(*taskDataSeq);
 }
 
 int main(int argc, char **argv) {
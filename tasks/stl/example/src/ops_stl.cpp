@@ -1,16 +1,12 @@
 // Copyright 2023 Nesterov Alexander
 #include "stl/example/include/ops_stl.hpp"
 
-#include <future>
-#include <iostream>
 #include <numeric>
 #include <random>
 #include <string>
-#include <thread>
-#include <utility>
 #include <vector>
 
-using namespace std::chrono_literals;
+#include "core/pool/include/thread_pool.hpp"
 
 std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
   std::random_device dev;
@@ -24,12 +20,9 @@ std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
 
 bool nesterov_a_test_task_stl::TestSTLTaskSequential::pre_processing() {
   internal_order_test();
-  // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  // Init vectors, capacity is reused by rebound task
   auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_.assign(tmp_ptr, tmp_ptr + taskData->inputs_count[0]);
   // Init value for output
   res = 0;
   return true;
@@ -57,33 +50,11 @@ bool nesterov_a_test_task_stl::TestSTLTaskSequential::post_processing() {
   return true;
 }
 
-std::mutex my_mutex;
-
-void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&pr) {
-  auto sz = vec.size();
-  int reduction_elem = 0;
-  if (ops == "+") {
-    for (size_t i = 0; i < sz; i++) {
-      std::lock_guard<std::mutex> my_lock(my_mutex);
-      reduction_elem += vec[i];
-    }
-  } else if (ops == "-") {
-    for (size_t i = 0; i < sz; i++) {
-      std::lock_guard<std::mutex> my_lock(my_mutex);
-      reduction_elem -= vec[i];
-    }
-  }
-  pr.set_value(reduction_elem);
-}
-
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::pre_processing() {
   internal_order_test();
-  // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  // Init vectors, capacity is reused by rebound task
   auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_.assign(tmp_ptr, tmp_ptr + taskData->inputs_count[0]);
   // Init value for output
   res = 0;
   return true;
@@ -97,24 +68,16 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::validation() {
 
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
   internal_order_test();
-  const auto nthreads = std::thread::hardware_concurrency();
-  const auto delta = (input_.end() - input_.begin()) / nthreads;
-
-  auto *promises = new std::promise<int>[nthreads];
-  auto *futures = new std::future<int>[nthreads];
-  auto *threads = new std::thread[nthreads];
-
-  for (unsigned i = 0; i < nthreads; i++) {
-    futures[i] = promises[i].get_future();
-    std::vector<int> tmp_vec(input_.begin() + i * delta, input_.begin() + (i + 1) * delta);
-    threads[i] = std::thread(atomOps, tmp_vec, ops, std::move(promises[i]));
-    threads[i].join();
-    res += futures[i].get();
+  // Threads of the shared pool sum chunks of input
+  auto sum = ppc::core::parallel_reduce(
+      0, input_.size(), 0,
+      [&](size_t begin, size_t end) { return std::accumulate(input_.begin() + begin, input_.begin() + end, 0); },
+      [](int lhs, int rhs) { return lhs + rhs; });
+  if (ops == "+") {
+    res = sum;
+  } else if (ops == "-") {
+    res = -sum;
   }
-
-  delete[] promises;
-  delete[] futures;
-  delete[] threads;
   return true;
 }
 
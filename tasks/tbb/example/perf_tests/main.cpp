@@ -2,24 +2,32 @@
 #include <gtest/gtest.h>
 #include <oneapi/tbb.h>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
+#include "core/perf/include/affinity_tbb.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_sweep.hpp"
 #include "tbb/example/include/ops_tbb.hpp"
 
+namespace {
+
+// buffers released by a test are reused by the next ones
+ppc::core::BufferArena arena;
+
+}  // namespace
+
 TEST(tbb_example_perf_test, test_pipeline_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskTBB = std::make_shared<nesterov_a_test_task_tbb::TestTBBTaskSequential>(taskDataSeq, "+");
@@ -29,6 +37,9 @@ TEST(tbb_example_perf_test, test_pipeline_run) {
   perfAttr->num_running = 10;
   const auto t0 = oneapi::tbb::tick_count::now();
   perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+  perfAttr->affinity = ppc::core::AffinityPolicy::COMPACT;
+  perfAttr->num_workers = oneapi::tbb::this_task_arena::max_concurrency();
+  const ppc::core::TbbAffinityObserver affinityObserver;
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -38,21 +49,18 @@ TEST(tbb_example_perf_test, test_pipeline_run) {
   perfAnalyzer->pipeline_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count + 1, out[0]);
+  arena.release(*taskDataSeq);
 }
 
 TEST(tbb_example_perf_test, test_task_run) {
   const int count = 100;
 
-  // Create data
-  std::vector<int> in(1, count);
-  std::vector<int> out(1, 0);
-
-  // Create TaskData
+  // Create TaskData with data in buffers of the arena
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  taskDataSeq->inputs_count.emplace_back(in.size());
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  taskDataSeq->outputs_count.emplace_back(out.size());
+  auto in = arena.add_input<int>(*taskDataSeq, 1);
+  in[0] = count;
+  auto out = arena.add_output<int>(*taskDataSeq, 1);
+  out[0] = 0;
 
   // Create Task
   auto testTaskTBB = std::make_shared<nesterov_a_test_task_tbb::TestTBBTaskSequential>(taskDataSeq, "+");
@@ -62,6 +70,9 @@ TEST(tbb_example_perf_test, test_task_run) {
   perfAttr->num_running = 10;
   const auto t0 = oneapi::tbb::tick_count::now();
   perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+  perfAttr->affinity = ppc::core::AffinityPolicy::COMPACT;
+  perfAttr->num_workers = oneapi::tbb::this_task_arena::max_concurrency();
+  const ppc::core::TbbAffinityObserver affinityObserver;
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -71,6 +82,54 @@ TEST(tbb_example_perf_test, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_EQ(count + 1, out[0]);
+  arena.release(*taskDataSeq);
+}
+
+TEST(tbb_example_perf_test, test_scaling_sweep) {
+  std::unique_ptr<oneapi::tbb::global_control> parallelism;
+  // Buffers of a measured point are reused by the next one
+  ppc::core::BufferArena sweepArena;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar;
+  std::vector<int> sums;
+  auto release_point = [&] {
+    sums.push_back(reinterpret_cast<int *>(taskDataPar->outputs[0])[0]);
+    sweepArena.release(*taskDataPar);
+  };
+
+  ppc::core::PerfSweep perfSweep([&](uint64_t size, uint64_t num_workers) -> std::shared_ptr<ppc::core::Task> {
+    // Limit is active till the next point
+    parallelism.reset();
+    parallelism = std::make_unique<oneapi::tbb::global_control>(
+        oneapi::tbb::global_control::max_allowed_parallelism, static_cast<size_t>(num_workers));
+    if (taskDataPar) release_point();
+    taskDataPar = std::make_shared<ppc::core::TaskData>();
+    auto in = sweepArena.add_input<int>(*taskDataPar, static_cast<uint32_t>(size));
+    std::fill(in.begin(), in.end(), 1);
+    sweepArena.add_output<int>(*taskDataPar, 1)[0] = 0;
+    return std::make_shared<nesterov_a_test_task_tbb::TestTBBTaskParallel>(taskDataPar, "+");
+  });
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const auto t0 = oneapi::tbb::tick_count::now();
+  perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+
+  ppc::core::SweepAttr sweepAttr;
+  sweepAttr.workers = {1, 2, 4};
+  sweepAttr.strong_size = 120000;
+  sweepAttr.weak_size_per_worker = 30000;
+
+  ppc::core::SweepResults sweepResults;
+  perfSweep.run(perfAttr, sweepAttr, sweepResults);
+  release_point();
+  parallelism.reset();
+  ppc::core::PerfSweep::print_sweep_statistic(sweepResults);
+  for (size_t i = 0; i < sweepResults.strong.size(); i++) {
+    ASSERT_EQ(sums[i], static_cast<int>(sweepAttr.strong_size) + 1);
+  }
+  // every point fits into buffers of the first one
+  EXPECT_EQ(sweepArena.allocations_count(), 2U);
 }
 
 int main(int argc, char **argv) {